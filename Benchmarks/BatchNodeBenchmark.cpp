@@ -0,0 +1,92 @@
+#include "BenchmarkApp.h"
+
+#include <random>
+
+#include "graphics/backend/MaskedSprite.h"
+#include "graphics/backend/MaskedSpriteBatchNode.h"
+
+#define SPRITE_COUNT    50000
+#define OPS_PER_FRAME   100  // Sorting is deferred until the batch node is visited, which happens once per frame
+#define RANDOM_SEED     1337
+#define MASK_FRAME_NAME "masks/opaque"
+
+USING_NS_AX;
+using namespace opendw;
+
+/*
+ * Adds and removes 50k sprites to and from a MaskedSpriteBatchNode in random order and reports how long it took,
+ * including the deferred sorting that the batch node does before drawing.
+ */
+static void runBenchmark()
+{
+    // Sprites are never drawn, so a single pixel is enough for both textures
+    uint8_t pixel[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    auto texture     = new Texture2D();
+    texture->initWithData(pixel, sizeof(pixel), backend::PixelFormat::RGBA8, 1, 1);
+    texture->autorelease();
+    SpriteFrameCache::getInstance()->addSpriteFrame(SpriteFrame::createWithTexture(texture, Rect(0, 0, 1, 1)),
+                                                    MASK_FRAME_NAME);
+
+    std::vector<MaskedSprite*> sprites;
+    sprites.reserve(SPRITE_COUNT);
+
+    for (auto i = 0; i < SPRITE_COUNT; i++)
+    {
+        auto sprite = MaskedSprite::createWithTexture(texture, texture);
+        sprite->retain();
+        sprites.push_back(sprite);
+    }
+
+    auto batchNode = MaskedSpriteBatchNode::createWithTexture(texture, texture);
+    batchNode->retain();
+    std::mt19937 generator(RANDOM_SEED);
+    std::shuffle(sprites.begin(), sprites.end(), generator);
+
+    // Randomly interleave adding the next sprite with removing a random sprite that has been added
+    std::vector<MaskedSprite*> added;
+    added.reserve(SPRITE_COUNT);
+    size_t nextSprite = 0;
+    size_t ops        = 0;
+    auto start        = utils::gettime();
+
+    while (nextSprite < sprites.size() || !added.empty())
+    {
+        if (nextSprite < sprites.size() && (added.empty() || generator() % 2 == 0))
+        {
+            auto sprite = sprites[nextSprite++];
+            batchNode->addChild(sprite);
+            added.push_back(sprite);
+        }
+        else
+        {
+            auto index   = generator() % added.size();
+            auto sprite  = added[index];
+            added[index] = added.back();
+            added.pop_back();
+            batchNode->removeChild(sprite);
+        }
+
+        if (++ops % OPS_PER_FRAME == 0)
+        {
+            batchNode->sortAllChildren();
+        }
+    }
+
+    batchNode->sortAllChildren();
+    auto elapsed = utils::gettime() - start;
+    AXLOGI("[BatchNodeBenchmark] {} operations on {} sprites took {:.2f}ms ({:.3f}us per operation)", ops,
+           SPRITE_COUNT, elapsed * 1000.0, elapsed * 1000000.0 / ops);
+
+    for (auto sprite : sprites)
+    {
+        sprite->release();
+    }
+
+    batchNode->release();
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkApp app("BatchNodeBenchmark", runBenchmark);
+    return Application::getInstance()->run();
+}
@@ -0,0 +1,38 @@
+#ifndef __BENCHMARK_APP_H__
+#define __BENCHMARK_APP_H__
+
+#include "axmol.h"
+
+/*
+ * Minimal application for benchmarks that need a graphics context, such as anything that creates sprites.
+ * Opens a small window, runs the benchmark once the engine has started and then quits.
+ */
+class BenchmarkApp : private ax::Application
+{
+public:
+    BenchmarkApp(std::string_view name, std::function<void()> benchmark) : _name(name), _benchmark(benchmark) {}
+
+    void initGfxContextAttrs() override
+    {
+        GfxContextAttrs gfxContextAttrs = {8, 8, 8, 8, 24, 8, 0};
+        ax::RenderView::setGfxContextAttrs(gfxContextAttrs);
+    }
+
+    bool applicationDidFinishLaunching() override
+    {
+        auto director = ax::Director::getInstance();
+        director->setRenderView(ax::RenderViewImpl::createWithRect(_name, ax::Rect(0, 0, 320, 240)));
+        _benchmark();
+        director->end();
+        return true;
+    }
+
+    void applicationDidEnterBackground() override {}
+    void applicationWillEnterForeground() override {}
+
+private:
+    std::string _name;
+    std::function<void()> _benchmark;
+};
+
+#endif  // __BENCHMARK_APP_H__
@@ -0,0 +1,152 @@
+#include <random>
+
+#include "axmol.h"
+
+#include "base/GameConfig.h"
+#include "base/Item.h"
+#include "util/MathUtil.h"
+#include "zone/FieldGrid.h"
+#include "zone/MetaBlock.h"
+
+#define ZONE_WIDTH      2000
+#define ZONE_HEIGHT     1000
+#define PROTECTOR_COUNT 1000
+#define QUERY_COUNT     100000
+#define RANDOM_SEED     1337
+
+USING_NS_AX;
+using namespace opendw;
+
+/*
+ * Compares FieldGrid lookups against a brute-force search over random points and reports the time both of them take.
+ * Runs the nearest damage field search with damage field counts on both sides of the linear search limit, and with
+ * points outside of the zone so that the ring search starts from a clamped cell.
+ * @return The number of lookups that did not match the brute-force result.
+ */
+static size_t runBenchmark(Item* protectorItem, Item* damageItem, size_t damageFieldCount)
+{
+    std::mt19937 generator(RANDOM_SEED + damageFieldCount);
+    std::uniform_int_distribution<int> blockX(0, ZONE_WIDTH - 1);
+    std::uniform_int_distribution<int> blockY(0, ZONE_HEIGHT - 1);
+    std::uniform_real_distribution<float> pointX(-100.0F, ZONE_WIDTH + 100.0F);
+    std::uniform_real_distribution<float> pointY(-100.0F, ZONE_HEIGHT + 100.0F);
+    FieldGrid grid;
+    grid.reset(ZONE_WIDTH, ZONE_HEIGHT);
+    Vector<MetaBlock*> fields;
+    std::vector<MetaBlock*> damageFields;
+
+    for (size_t i = 0; i < PROTECTOR_COUNT + damageFieldCount; i++)
+    {
+        auto item      = i < PROTECTOR_COUNT ? protectorItem : damageItem;
+        auto metaBlock = MetaBlock::createWithData(blockX(generator), blockY(generator), item, ValueMapNull);
+        fields.pushBack(metaBlock);
+        grid.addField(metaBlock);
+
+        if (item == damageItem)
+        {
+            damageFields.push_back(metaBlock);
+        }
+    }
+
+    // Count the fields that cover a block the same way BaseBlock::isProtectedByField looks for them
+    auto isCovering = [](MetaBlock* field, int16_t x, int16_t y) {
+        return math_util::getDistance(x, y, field->getX(), field->getY()) <= field->getItem()->getField();
+    };
+
+    size_t mismatches      = 0;
+    double coverTime       = 0.0;
+    double linearCoverTime = 0.0;
+
+    for (auto i = 0; i < QUERY_COUNT; i++)
+    {
+        auto x            = (int16_t)blockX(generator);
+        auto y            = (int16_t)blockY(generator);
+        auto start        = utils::gettime();
+        size_t coverCount = 0;
+
+        for (auto field : grid.getFieldsAt(x, y))
+        {
+            coverCount += isCovering(field, x, y);
+        }
+
+        coverTime += utils::gettime() - start;
+
+        // Brute force
+        start                     = utils::gettime();
+        size_t expectedCoverCount = 0;
+
+        for (auto field : fields)
+        {
+            expectedCoverCount += isCovering(field, x, y);
+        }
+
+        linearCoverTime += utils::gettime() - start;
+
+        if (coverCount != expectedCoverCount)
+        {
+            mismatches++;
+        }
+    }
+
+    // The nearest damage field may differ on ties, so compare distances instead
+    double gridTime   = 0.0;
+    double linearTime = 0.0;
+
+    for (auto i = 0; i < QUERY_COUNT; i++)
+    {
+        auto x       = pointX(generator);
+        auto y       = pointY(generator);
+        auto start   = utils::gettime();
+        auto nearest = grid.findNearestDamageField(x, y);
+        gridTime += utils::gettime() - start;
+
+        // Brute force
+        start                 = utils::gettime();
+        MetaBlock* expected   = nullptr;
+        auto expectedDistance = 0.0F;
+
+        for (auto field : damageFields)
+        {
+            auto distance = math_util::getDistance(x, y, field->getX(), field->getY());
+
+            if (!expected || distance < expectedDistance)
+            {
+                expected         = field;
+                expectedDistance = distance;
+            }
+        }
+
+        linearTime += utils::gettime() - start;
+
+        if (!nearest != !expected ||
+            (nearest && math_util::getDistance(x, y, nearest->getX(), nearest->getY()) != expectedDistance))
+        {
+            mismatches++;
+        }
+    }
+
+    AXLOGI("[FieldGridBenchmark] {} protectors, {} damage fields, {} queries each: coverage took {:.2f}ms (brute "
+           "force: {:.2f}ms), nearest damage field took {:.2f}ms (brute force: {:.2f}ms), {} mismatches",
+           PROTECTOR_COUNT, damageFieldCount, QUERY_COUNT, coverTime * 1000.0, linearCoverTime * 1000.0,
+           gridTime * 1000.0, linearTime * 1000.0, mismatches);
+    return mismatches;
+}
+
+int main(int argc, char** argv)
+{
+    auto config        = GameConfig::createWithData(ValueMapNull);
+    auto protectorItem = Item::createWithManager(config, {{"code", Value(1)}, {"field", Value(10)}}, "protector");
+    auto damageData    = ValueMap{{"code", Value(2)},
+                                  {"field", Value(8)},
+                                  {"field_damage", Value(ValueVector{Value("fire"), Value(5)})}};
+    auto damageItem    = Item::createWithManager(config, damageData, "damage-field");
+    size_t mismatches  = 0;
+
+    // Below, at and above the linear search limit, and then enough fields for the ring search to stop early
+    for (size_t count : {0, 1, 8, 9, 100, 1000})
+    {
+        mismatches += runBenchmark(protectorItem, damageItem, count);
+    }
+
+    return mismatches == 0 ? 0 : 1;
+}
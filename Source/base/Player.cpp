@@ -140,6 +140,7 @@ void Player::configureAvatar(const ValueMap& data)
     }
 
     _physical->addToSpace();
+    WorldZone::getMain()->registerEntity(_avatar);
 }
 
 void Player::begin()
@@ -155,6 +156,12 @@ void Player::reset()
 {
     AXLOGI("[Player] reset");
     _physical = nullptr;  // Managed by avatar, no need to release
+
+    if (_avatar && WorldZone::getMain())
+    {
+        WorldZone::getMain()->unregisterEntity(_avatar);
+    }
+
     AX_SAFE_RELEASE_NULL(_avatar);
     _inventory.clear();
     _cachedAccessoryItems.clear();
@@ -1024,8 +1031,9 @@ BaseBlock* Player::tryToMineBlockAtNodePoint(const Point& point, InventoryItem*
 
         if (toolSwung)
         {
-            auto sprite = target->getMainSpriteForLayer(layer);
-            zone->getWorldRenderer()->glowSprite(sprite);
+            auto renderer = zone->getWorldRenderer();
+            renderer->unbakeBlock(target);
+            renderer->glowSprite(target->getMainSpriteForLayer(layer));
 
             // 0x100024892: Show protected field alert
             if (_miningAttempts == 3)
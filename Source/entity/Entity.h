@@ -142,6 +142,10 @@ public:
 
     Physical* getPhysical() const { return _physical; }
 
+    /* Position of this entity in the live entities of its zone, or -1. Maintained by WorldZone. */
+    void setZoneIndex(ssize_t index) { _zoneIndex = index; }
+    ssize_t getZoneIndex() const { return _zoneIndex; }
+
 protected:
     EntityConfig* _config;                   // Entity::config @ 0x1003128A0
     EntityConfig* _aggregateConfig;          // Entity::aggregateConfig @ 0x100312928
@@ -168,6 +172,7 @@ protected:
     float _emoteOffset;                      // Entity::emoteCount @ 0x100312998
     Physical* _physical;                     // NOTE: Originally inherited from GameObject
     double _nextFX;
+    ssize_t _zoneIndex = -1;
 };
 
 }  // namespace opendw
@@ -0,0 +1,87 @@
+#include "BlockRenderQueue.h"
+
+#include "zone/BaseBlock.h"
+
+#define BUCKET_COUNT      64  // Blocks further away than this all share the last bucket
+#define REBUCKET_DISTANCE 4   // Distance the center can move before blocks are resorted
+
+namespace opendw
+{
+
+BlockRenderQueue::BlockRenderQueue()
+{
+    _buckets.resize(BUCKET_COUNT);
+}
+
+void BlockRenderQueue::setCenter(int16_t x, int16_t y)
+{
+    _centerX = x;
+    _centerY = y;
+
+    if (abs(x - _bucketedX) < REBUCKET_DISTANCE && abs(y - _bucketedY) < REBUCKET_DISTANCE)
+    {
+        return;
+    }
+
+    _bucketedX = x;
+    _bucketedY = y;
+
+    if (_size == 0)
+    {
+        return;
+    }
+
+    // Take everything out in the current order so that blocks at equal distance keep their relative order
+    _scratch.clear();
+    _scratch.reserve(_size);
+    forEach([this](BaseBlock* block) { _scratch.push_back(block); });
+    clear();
+
+    for (auto block : _scratch)
+    {
+        push(block);
+    }
+}
+
+void BlockRenderQueue::push(BaseBlock* block)
+{
+    auto index = getBucketIndex(block);
+    _buckets[index].push(block);
+    _nearestBucket = MIN(_nearestBucket, index);
+    _size++;
+}
+
+BaseBlock* BlockRenderQueue::pop()
+{
+    AX_ASSERT(_size > 0);
+
+    while (_buckets[_nearestBucket].empty())
+    {
+        _nearestBucket++;
+    }
+
+    auto& bucket = _buckets[_nearestBucket];
+    auto block   = bucket.front();
+    bucket.pop();
+    _size--;
+    return block;
+}
+
+void BlockRenderQueue::clear()
+{
+    for (auto& bucket : _buckets)
+    {
+        bucket.clear();
+    }
+
+    _nearestBucket = 0;
+    _size          = 0;
+}
+
+size_t BlockRenderQueue::getBucketIndex(BaseBlock* block) const
+{
+    auto distance = MAX(abs(block->getX() - _centerX), abs(block->getY() - _centerY));
+    return MIN((size_t)distance, (size_t)BUCKET_COUNT - 1);
+}
+
+}  // namespace opendw
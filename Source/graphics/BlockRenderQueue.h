@@ -0,0 +1,64 @@
+#ifndef __BLOCK_RENDER_QUEUE_H__
+#define __BLOCK_RENDER_QUEUE_H__
+
+#include "axmol.h"
+
+#include "util/RingQueue.h"
+
+namespace opendw
+{
+
+class BaseBlock;
+
+/*
+ * Render queue that hands out blocks nearest to the viewport center first.
+ * Blocks are sorted into buckets by their Chebyshev distance to the center at the time they are pushed. Blocks in the
+ * same bucket are handed out in the order they were pushed. The buckets are only rebuilt once the center has moved far
+ * enough for the sorting to be noticeably off, so small camera movements cost nothing.
+ */
+class BlockRenderQueue
+{
+public:
+    BlockRenderQueue();
+
+    /* Sets the point distances are measured from, rebucketing all queued blocks if it has moved far enough. */
+    void setCenter(int16_t x, int16_t y);
+
+    void push(BaseBlock* block);
+
+    /* Removes and returns the nearest queued block. The queue must not be empty. */
+    BaseBlock* pop();
+
+    void clear();
+
+    template <typename Callback>
+    void forEach(Callback&& callback) const
+    {
+        for (auto& bucket : _buckets)
+        {
+            for (size_t i = 0; i < bucket.size(); i++)
+            {
+                callback(bucket[i]);
+            }
+        }
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+private:
+    size_t getBucketIndex(BaseBlock* block) const;
+
+    std::vector<RingQueue<BaseBlock*>> _buckets;
+    std::vector<BaseBlock*> _scratch;  // Used while rebucketing
+    size_t _nearestBucket = 0;         // No bucket before this one contains any blocks
+    size_t _size          = 0;
+    int16_t _centerX      = 0;
+    int16_t _centerY      = 0;
+    int16_t _bucketedX    = 0;  // Center the current buckets are sorted around
+    int16_t _bucketedY    = 0;
+};
+
+}  // namespace opendw
+
+#endif  // __BLOCK_RENDER_QUEUE_H__
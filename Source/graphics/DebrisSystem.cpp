@@ -0,0 +1,302 @@
+#include "DebrisSystem.h"
+
+#include "base/Item.h"
+#include "graphics/backend/MaskedSprite.h"
+#include "graphics/backend/MaskedSpriteBatchNode.h"
+#include "physics/ChipmunkSpace.h"
+#include "zone/BaseBlock.h"
+#include "zone/WorldChunk.h"
+#include "zone/WorldZone.h"
+#include "CommonDefs.h"
+#include "GameManager.h"
+
+#define MAX_PARTICLES    4096
+#define MAX_STEP_TIME    (1.0F / 60.0F)  // Longer frames are split up so particles can't skip through blocks
+#define DEBRIS_LIFE      1.2F
+#define DEBRIS_FADE_TIME 0.5F
+#define DEBRIS_MASK      "masks/blob"
+
+// Chipmunk multiplies the values of both shapes, so these match the old debris circles colliding with block boxes
+#define DEBRIS_ELASTICITY (0.3F * 0.3F)
+#define DEBRIS_FRICTION   (0.05F * 0.3F)
+
+USING_NS_AX;
+
+namespace opendw
+{
+
+/* Reflects the normal component of a velocity and applies Coulomb friction to the tangential component. */
+static void bounce(float& normal, float& tangent)
+{
+    auto impulse = fabsf(normal) * (1.0F + DEBRIS_ELASTICITY);
+    auto limit   = impulse * DEBRIS_FRICTION;
+    normal       = -normal * DEBRIS_ELASTICITY;
+    tangent      = fabsf(tangent) <= limit ? 0.0F : tangent - copysignf(limit, tangent);
+}
+
+DebrisSystem* DebrisSystem::createWithBatchNode(MaskedSpriteBatchNode* batchNode)
+{
+    CREATE_INIT(DebrisSystem, initWithBatchNode, batchNode);
+}
+
+bool DebrisSystem::initWithBatchNode(MaskedSpriteBatchNode* batchNode)
+{
+    AXASSERT(batchNode, "Batch node can't be nullptr");
+
+    if (!Node::init())
+    {
+        return false;
+    }
+
+    _batchNode = batchNode;
+    _zone      = GameManager::getInstance()->getZone();
+    _lastChunk = nullptr;
+
+    // Every particle uses the same mask, so its coordinates only have to be calculated once
+    auto frame = SpriteFrameCache::getInstance()->findFrame(DEBRIS_MASK);
+    AXASSERT(frame, "Debris mask frame is missing");
+    auto& maskRect    = frame->getRect();
+    auto& textureSize = batchNode->getMaskTexture()->getContentSize();
+    _maskSize         = maskRect.size;
+    _maskMin          = Tex2F(maskRect.getMinX() / textureSize.width, maskRect.getMinY() / textureSize.height);
+    _maskMax          = Tex2F(maskRect.getMaxX() / textureSize.width, maskRect.getMaxY() / textureSize.height);
+    scheduleUpdate();
+    return true;
+}
+
+void DebrisSystem::update(float deltaTime)
+{
+    if (_x.empty())
+    {
+        return;
+    }
+
+    deltaTime  = MIN(MAX_DELTA_TIME, deltaTime);
+    _lastChunk = nullptr;  // Chunks may have been recycled since the last frame
+    auto steps = (int)ceilf(deltaTime / MAX_STEP_TIME);
+
+    for (int i = 0; i < steps; i++)
+    {
+        step(deltaTime / steps);
+    }
+
+    // Iterate backwards so that removed particles can be replaced by the last one
+    for (auto i = _x.size(); i-- > 0;)
+    {
+        _life[i] -= deltaTime;
+
+        if (_life[i] <= -DEBRIS_FADE_TIME)
+        {
+            removeParticle(i);
+        }
+    }
+}
+
+void DebrisSystem::step(float deltaTime)
+{
+    auto gravity = _zone->getSpace()->getGravity() * deltaTime;
+
+    for (size_t i = 0; i < _x.size(); i++)
+    {
+        auto& x         = _x[i];
+        auto& y         = _y[i];
+        auto& velocityX = _velocityX[i];
+        auto& velocityY = _velocityY[i];
+        auto radius     = _radius[i];
+        velocityX += gravity.x;
+        velocityY += gravity.y;
+
+        // Particles that start inside a block (which is where mining debris comes from) move freely until they leave it
+        if (isSolidAt(x, y))
+        {
+            x += velocityX * deltaTime;
+            y += velocityY * deltaTime;
+            continue;
+        }
+
+        // Move one axis at a time and bounce off whatever the leading edge runs into
+        auto nextX = x + velocityX * deltaTime;
+
+        if (velocityX != 0.0F && isSolidAt(nextX + copysignf(radius, velocityX), y))
+        {
+            bounce(velocityX, velocityY);
+        }
+        else
+        {
+            x = nextX;
+        }
+
+        auto nextY = y + velocityY * deltaTime;
+
+        if (velocityY != 0.0F && isSolidAt(x, nextY + copysignf(radius, velocityY)))
+        {
+            bounce(velocityY, velocityX);
+        }
+        else
+        {
+            y = nextY;
+        }
+    }
+}
+
+void DebrisSystem::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+    auto count = _x.size();
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    _quads.resize(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto& quad   = _quads[i];
+        auto halfW   = _maskSize.width * _scale[i] * 0.5F;
+        auto halfH   = _maskSize.height * _scale[i] * 0.5F;
+        auto cosine  = cosf(_angle[i]);
+        auto sine    = sinf(_angle[i]);
+        auto color   = _color[i];
+        auto& texMin = _textureMin[i];
+        auto& texMax = _textureMax[i];
+
+        // Same as a sprite that has been rotated clockwise around its center
+        auto setVertex = [&](MaskedQuadCommand::Vertex& vertex, float x, float y) {
+            vertex.position.set(_x[i] + x * cosine + y * sine, _y[i] - x * sine + y * cosine, 0.0F);
+            vertex.color = color;
+        };
+
+        if (_life[i] < 0.0F)
+        {
+            color.a = (uint8_t)(color.a * (1.0F + _life[i] / DEBRIS_FADE_TIME));
+        }
+
+        setVertex(quad.tl, -halfW, halfH);
+        setVertex(quad.bl, -halfW, -halfH);
+        setVertex(quad.tr, halfW, halfH);
+        setVertex(quad.br, halfW, -halfH);
+        quad.tl.texCoord  = Tex2F(texMin.u, texMin.v);
+        quad.bl.texCoord  = Tex2F(texMin.u, texMax.v);
+        quad.tr.texCoord  = Tex2F(texMax.u, texMin.v);
+        quad.br.texCoord  = Tex2F(texMax.u, texMax.v);
+        quad.tl.maskCoord = Tex2F(_maskMin.u, _maskMin.v);
+        quad.bl.maskCoord = Tex2F(_maskMin.u, _maskMax.v);
+        quad.tr.maskCoord = Tex2F(_maskMax.u, _maskMin.v);
+        quad.br.maskCoord = Tex2F(_maskMax.u, _maskMax.v);
+    }
+
+    _quadCommand.init(_globalZOrder, _batchNode->getTexture(), _batchNode->getMaskTexture(),
+                      _batchNode->getBlendFunc(), _quads.data(), static_cast<int>(count), transform, flags);
+    _quadCommand.populateBuffers(0, static_cast<int>(count));
+    renderer->addCommand(&_quadCommand);
+}
+
+bool DebrisSystem::spawnForSprite(MaskedSprite* sprite, const Point& position, const Vec2& velocity, float angle)
+{
+    AXASSERT(sprite->getParent() == _batchNode, "Sprite must be in the batch node of this debris system");
+
+    if (_x.size() >= MAX_PARTICLES)
+    {
+        return false;
+    }
+
+    // Cut a mask-sized piece out of the center of the sprite
+    auto texture     = _batchNode->getTexture();
+    auto textureRect = AX_RECT_POINTS_TO_PIXELS(sprite->getTextureRect());
+    auto maskSize    = AX_SIZE_POINTS_TO_PIXELS(_maskSize);
+    auto origin      = textureRect.origin + (textureRect.size - maskSize) * 0.5F;
+    auto width       = (float)texture->getPixelsWide();
+    auto height      = (float)texture->getPixelsHigh();
+    auto scale       = random(0.9F, 1.1F);
+    auto& color      = sprite->getColor();
+    _x.push_back(position.x);
+    _y.push_back(position.y);
+    _velocityX.push_back(velocity.x);
+    _velocityY.push_back(velocity.y);
+    _radius.push_back(BLOCK_SIZE * 0.1F * scale);
+    _scale.push_back(scale);
+    _angle.push_back(angle);
+    _life.push_back(DEBRIS_LIFE);
+    _color.push_back(Color4B(color.r, color.g, color.b, sprite->getOpacity()));  // RGB is not premultiplied for masks
+    _textureMin.push_back(Tex2F(origin.x / width, origin.y / height));
+    _textureMax.push_back(Tex2F((origin.x + maskSize.width) / width, (origin.y + maskSize.height) / height));
+    return true;
+}
+
+void DebrisSystem::clear()
+{
+    _x.clear();
+    _y.clear();
+    _velocityX.clear();
+    _velocityY.clear();
+    _radius.clear();
+    _scale.clear();
+    _angle.clear();
+    _life.clear();
+    _color.clear();
+    _textureMin.clear();
+    _textureMax.clear();
+    _lastChunk = nullptr;
+}
+
+void DebrisSystem::removeParticle(size_t index)
+{
+    // Swap with the last particle to keep the arrays dense
+    auto last          = _x.size() - 1;
+    _x[index]          = _x[last];
+    _y[index]          = _y[last];
+    _velocityX[index]  = _velocityX[last];
+    _velocityY[index]  = _velocityY[last];
+    _radius[index]     = _radius[last];
+    _scale[index]      = _scale[last];
+    _angle[index]      = _angle[last];
+    _life[index]       = _life[last];
+    _color[index]      = _color[last];
+    _textureMin[index] = _textureMin[last];
+    _textureMax[index] = _textureMax[last];
+    _x.pop_back();
+    _y.pop_back();
+    _velocityX.pop_back();
+    _velocityY.pop_back();
+    _radius.pop_back();
+    _scale.pop_back();
+    _angle.pop_back();
+    _life.pop_back();
+    _color.pop_back();
+    _textureMin.pop_back();
+    _textureMax.pop_back();
+}
+
+bool DebrisSystem::isSolidAt(float x, float y)
+{
+    auto blockX = (int)floorf(x / BLOCK_SIZE);
+    auto blockY = (int)floorf(-y / BLOCK_SIZE);
+
+    if (blockX < 0 || blockX >= _zone->getBlocksWidth() || blockY < 0 || blockY >= _zone->getBlocksHeight())
+    {
+        return false;
+    }
+
+    auto chunkWidth  = _zone->getChunkWidth();
+    auto chunkHeight = _zone->getChunkHeight();
+    auto chunkX      = blockX / chunkWidth;
+    auto chunkY      = blockY / chunkHeight;
+
+    if (!_lastChunk || _lastChunk->getX() != chunkX || _lastChunk->getY() != chunkY)
+    {
+        _lastChunk = _zone->getChunkAt(chunkX, chunkY);
+
+        if (!_lastChunk)
+        {
+            return false;
+        }
+    }
+
+    // NOTE: Items that span multiple blocks only occupy their origin block here
+    auto block = _lastChunk->getBlockAtSlot((blockY % chunkHeight) * chunkWidth + blockX % chunkWidth);
+    auto item  = block->getFrontItem();
+    return item && item->getShape() != Item::Shape::NONE;
+}
+
+}  // namespace opendw
@@ -0,0 +1,76 @@
+#ifndef __DEBRIS_SYSTEM_H__
+#define __DEBRIS_SYSTEM_H__
+
+#include "axmol.h"
+
+#include "graphics/backend/MaskedQuadCommand.h"
+
+namespace opendw
+{
+
+class MaskedSprite;
+class MaskedSpriteBatchNode;
+class WorldChunk;
+class WorldZone;
+
+/*
+ * Lightweight particle simulator for block debris.
+ * Particles are stored as parallel arrays, integrate their own velocity and gravity and collide against the block grid
+ * of the zone directly instead of going through Chipmunk. Everything is drawn with a single command using the
+ * textures of a batch node, so the renderer it belongs to can host as many particles as it likes.
+ */
+class DebrisSystem : public ax::Node
+{
+public:
+    typedef MaskedQuadCommand::Quad Quad;
+
+    static DebrisSystem* createWithBatchNode(MaskedSpriteBatchNode* batchNode);
+
+    bool initWithBatchNode(MaskedSpriteBatchNode* batchNode);
+
+    void update(float deltaTime) override;
+    void draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags) override;
+
+    /*
+     * Spawns a blob-shaped chunk of the specified sprite, which must be in the batch node of this system.
+     * @return Whether the particle was spawned. Fails if the particle budget has been used up.
+     */
+    bool spawnForSprite(MaskedSprite* sprite, const ax::Point& position, const ax::Vec2& velocity, float angle);
+
+    void clear();
+
+    size_t getParticleCount() const { return _x.size(); }
+
+private:
+    void step(float deltaTime);
+    void removeParticle(size_t index);
+
+    /* @return Whether the block at the specified node point has a physics shape. */
+    bool isSolidAt(float x, float y);
+
+    MaskedSpriteBatchNode* _batchNode;  // Provides the textures and blend function
+    WorldZone* _zone;
+    WorldChunk* _lastChunk;             // Most recently looked up chunk; particles tend to stay close together
+    ax::Size _maskSize;
+    ax::Tex2F _maskMin;
+    ax::Tex2F _maskMax;
+    MaskedQuadCommand _quadCommand;
+    std::vector<Quad> _quads;
+
+    // Particle data
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _velocityX;
+    std::vector<float> _velocityY;
+    std::vector<float> _radius;
+    std::vector<float> _scale;
+    std::vector<float> _angle;
+    std::vector<float> _life;
+    std::vector<ax::Color4B> _color;
+    std::vector<ax::Tex2F> _textureMin;
+    std::vector<ax::Tex2F> _textureMax;
+};
+
+}  // namespace opendw
+
+#endif  // __DEBRIS_SYSTEM_H__
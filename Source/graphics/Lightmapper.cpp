@@ -9,13 +9,20 @@
 #include "graphics/WorldRenderer.h"
 #include "util/MapUtil.h"
 #include "util/MathUtil.h"
+#include "util/ThreadPool.h"
 #include "zone/BaseBlock.h"
+#include "zone/BlockRectRange.h"
 #include "zone/MetaBlock.h"
+#include "zone/WorldChunk.h"
 #include "zone/WorldZone.h"
 #include "CommonDefs.h"
 #include "GameManager.h"
 
 #define LIGHT_RING_ITERATIONS      8
+#define MAX_LIGHT_OFFSET           2  // Largest light position offset that is accounted for when finding light sources
+#define LIGHT_SOURCE_PADDING       (LIGHT_RING_ITERATIONS + MAX_LIGHT_OFFSET)
+#define MAX_WORKER_THREADS         3
+#define MIN_BAND_ROWS              8  // Fewest block rows that are worth handing to another thread
 #define LIGHTMAP_SCALE             0.5
 #define LIGHTMAP_SHADER            "custom/Lightmap_fs"
 #define TEXTURE_PADDING            LIGHT_RING_ITERATIONS
@@ -32,6 +39,32 @@ namespace opendw
 static const auto kOverlayColor      = Color4F{25.0F, 15.0F, 3.0F, 250.0F};
 static const auto kDeathOverlayColor = Color4F{30.0F, 5.0F, 5.0F, 160.0F};
 
+// Scratch buffer for computeLight, which runs on several threads at once
+static thread_local std::vector<BaseBlock*> sLightSources;
+
+/* Same as WorldZone::getBlockAt, but safe to call from worker threads because it skips the lookup cache. */
+static BaseBlock* findBlockAt(const WorldZone* zone, int16_t x, int16_t y)
+{
+    if (x < 0 || x >= zone->getBlocksWidth() || y < 0 || y >= zone->getBlocksHeight())
+    {
+        return nullptr;
+    }
+
+    auto chunkWidth  = zone->getChunkWidth();
+    auto chunkHeight = zone->getChunkHeight();
+    auto chunk       = zone->getChunkAt(x / chunkWidth, y / chunkHeight);
+    return chunk ? chunk->getBlockAtSlot((y % chunkHeight) * chunkWidth + x % chunkWidth) : nullptr;
+}
+
+/* @return The specified horizontal band of a block rect that has been split into the specified number of bands. */
+static Rect getBand(const Rect& rect, size_t band, size_t bandCount)
+{
+    auto rows = (size_t)rect.size.height + 1;
+    auto minY = rect.getMinY() + rows * band / bandCount;
+    auto maxY = rect.getMinY() + rows * (band + 1) / bandCount - 1;
+    return Rect(rect.getMinX(), minY, rect.size.width, maxY - minY);
+}
+
 Lightmapper::~Lightmapper()
 {
     AX_SAFE_DELETE_ARRAY(_lightRings);
@@ -40,6 +73,7 @@ Lightmapper::~Lightmapper()
     AX_SAFE_RELEASE(_texture);
     AX_SAFE_RELEASE(_sprite);
     AX_SAFE_RELEASE(_programState);
+    AX_SAFE_DELETE(_threadPool);
 }
 
 Lightmapper* Lightmapper::createWithZone(WorldZone* zone)
@@ -56,6 +90,11 @@ bool Lightmapper::initWithZone(WorldZone* zone)
 
     _zone             = zone;
     _defaultBaseLight = DEFAULT_BASE_LIGHT;
+    _litRect          = Rect(0.0F, 0.0F, -1.0F, -1.0F);  // Nothing has been lit yet
+
+    // The main thread takes part in the work as well
+    auto cores  = std::thread::hardware_concurrency();
+    _threadPool = new ThreadPool(cores > 1 ? MIN(MAX_WORKER_THREADS, cores - 1) : 0);
 
     // Create texture
     _texture = new Texture2D();
@@ -165,7 +204,6 @@ void Lightmapper::update(float deltaTime)
     _ul                = ul - Vec2::ONE * TEXTURE_PADDING;
     _lr                = _zone->getLowerRightScreenBlockPoint() + Vec2::ONE * TEXTURE_PADDING;
     auto blocksRect    = Rect(_ul.x, _ul.y, _lr.x - _ul.x, _lr.y - _ul.y);
-    _screenBlocks      = _zone->getBlocksInRect(blocksRect);
 
     // Recreate texture if world scale & screen rect size have changed
     // FIXME: Might not always update when it is supposed to
@@ -237,6 +275,56 @@ void Lightmapper::update(float deltaTime)
 }
 
 void Lightmapper::illuminateBlocks(float deltaTime)
+{
+    // Bring the cached light of blocks on screen up to date
+    collectDirtyLight();
+    float dirtyArea = 0.0F;
+
+    for (auto& rect : _dirtyRects)
+    {
+        dirtyArea += (rect.size.width + 1.0F) * (rect.size.height + 1.0F);
+    }
+
+    // Overlapping rects are recomputed more than once, so just do everything once they cover as much as the screen
+    if (dirtyArea >= (_screenRect.size.width + 1.0F) * (_screenRect.size.height + 1.0F))
+    {
+        computeBands(_screenRect, getBandCount(_screenRect));
+    }
+    else
+    {
+        for (auto& rect : _dirtyRects)
+        {
+            computeBands(rect, getBandCount(rect));
+        }
+    }
+
+    _dirtyRects.clear();
+    auto screenBlockCount = composeTexture(getBandCount(_screenRect));
+    _texture->updateWithData(_textureData, _textureSizeBytes, backend::PixelFormat::RGBA8, backend::PixelFormat::RGBA8,
+                             _textureWidth, _textureHeight, false);
+    MathUtil::smooth(&_flash, 0.0F, deltaTime * 3.0F, 0.1F);
+
+    if (_flash < 0.01F)
+    {
+        _flash = 0.01F;
+    }
+
+    // 0x100058BB3: Update sky coverage & visibility
+    // FIXME: There's somewhat of an inaccuracy caused by the padding used by the lightmapper
+    auto biomeType   = _zone->getBiomeType();
+    auto skyCoverage = clampf((float)_skyBlocksVisible / screenBlockCount, 0.0F, 1.0F);
+    _zone->setSkyCoverage(skyCoverage);
+    _skyVisible    = _skyBlocksVisible > 0 || biomeType == Biome::SPACE;
+    _cavernVisible = !_skyVisible && _cavernBlocksVisible > 0 && biomeType != Biome::SPACE;
+}
+
+void Lightmapper::computeBands(const Rect& rect, size_t bandCount)
+{
+    // Bands of the same rect only write to their own blocks, but separate rects may overlap and are done one by one
+    _threadPool->run(bandCount, [&](size_t band) { computeLight(getBand(rect, band, bandCount)); });
+}
+
+size_t Lightmapper::composeTexture(size_t bandCount)
 {
     // Reset state
     memset(_textureData, 0x7F, _textureSizeBytes);
@@ -244,57 +332,231 @@ void Lightmapper::illuminateBlocks(float deltaTime)
     _skyBlocksVisible    = 0;
     _cavernBlocksVisible = 0;
 
-    for (auto block : _screenBlocks)
+    // Values that are the same for every block
+    auto baseLight        = getBaseLight();
+    auto thunder          = _zone->getWorldRenderer()->getSky()->getThunder();
+    auto cloudCover       = _zone->getCloudCover() * -0.4F + 1.0F;
+    cloudCover            = math_util::lerp(cloudCover, 1.0F, thunder);
+    auto daylight         = math_util::lerp(_zone->getDayPercent(), 1.0F, thunder);
+    auto elapsedTime      = GameManager::getInstance()->getElapsedTime();
+    auto fieldDamageBlock = _zone->getFieldDamageBlock();
+    auto overlay          = MAX(_overlay, _deathOverlay);
+    auto overlayColor     = Player::getMain()->getHealth() <= 0.0F ? kDeathOverlayColor : kOverlayColor;
+
+#if RESTRICT_FIELD_DAMAGE_AURA
+    if (_zone->getBiomeType() != Biome::HELL)
+    {
+        fieldDamageBlock = nullptr;
+    }
+#endif
+
+    // Bands write to separate rows of the texture and count visible blocks on their own
+    _bandCounters.resize(bandCount);
+
+    // 0x100057824: Pass 2 (sunlight & liquid lighting)
+    // NOTE: the light values of pass 1, sunlight and liquid lighting are cached per block by computeLight
+    _threadPool->run(bandCount, [&](size_t band) {
+        BlockRectRange bandBlocks(_zone, getBand(_screenRect, band, bandCount));
+        BandCounters counters = {};
+
+        for (auto block : bandBlocks)
+        {
+            auto x     = block->getX();
+            auto y     = block->getY();
+            auto front = block->getFrontItem();
+            counters.blocks++;
+
+            // 0x1000578BA: Increment visible base block counter
+            auto base = block->getBase();
+
+            if (base < 2 && !block->isOpaque())
+            {
+                if (base == 0)
+                {
+                    counters.skyBlocks++;
+                }
+                else  // 1 = base/empty
+                {
+                    counters.cavernBlocks++;
+                }
+            }
+
+            auto light = block->getCurrentLightSun();
+            auto red   = block->getCurrentLightR();
+            auto green = block->getCurrentLightG();
+            auto blue  = block->getCurrentLightB();
+            auto alpha = clampf(baseLight - block->getCurrentLightA(), 0.0F, 255.0F);
+            alpha -= math_util::lerp(light * cloudCover * daylight, 255.0F, _flash);
+
+            // 0x10005866B: Apply pulsating glow effect
+            // FIXME: take light position into account
+            if (front->getLight() > 0.0F)
+            {
+                auto offset = math_util::lerp(4.0F, 7.0F, (float)x / y);
+                auto glow   = sinf(offset * ((float)y + x + elapsedTime)) * 10.0F + 10.0F;
+                red -= glow;
+                green -= glow;
+                blue -= glow;
+            }
+
+            // 0x10005873E: Show field damage radius
+            if (fieldDamageBlock)
+            {
+                auto& color    = fieldDamageBlock->getItem()->getColor();
+                auto distance  = math_util::getDistance(x, y, fieldDamageBlock->getX(), fieldDamageBlock->getY());
+                auto intensity = distance / -50.0F + 1.0F;
+                red            = math_util::lerp(red, color.r, intensity);
+                green          = math_util::lerp(green, color.g, intensity);
+                blue           = math_util::lerp(blue, color.b, intensity);
+            }
+
+            // 0x100058845: Apply overlay (haze)
+            if (overlay > 0.0F)
+            {
+                red   = math_util::lerp(red, overlayColor.r, overlay);
+                green = math_util::lerp(green, overlayColor.g, overlay);
+                blue  = math_util::lerp(blue, overlayColor.b, overlay);
+                alpha = math_util::lerp(alpha, overlayColor.a, overlay);
+            }
+
+            red   = clampf(red, 0.0F, 255.0F);
+            green = clampf(green, 0.0F, 255.0F);
+            blue  = clampf(blue, 0.0F, 255.0F);
+            alpha = clampf(alpha, 0.0F, 255.0F);
+
+            // 0x100058A72: Set pixel in texture
+            auto pixelX = (ssize_t)(floor(x - _ul.x));
+            auto pixelY = (ssize_t)(floor(y - _ul.y));
+            auto pixel  = (pixelY * _textureWidth + pixelX) * 4;
+
+            // FIXME: This CAN happen, and while it *shouldn't* really matter, it'd be better if it didn't.
+            if (pixel >= 0 && pixel + 3 < _textureSizeBytes)
+            {
+                _textureData[pixel]     = (uint8_t)red;
+                _textureData[pixel + 1] = (uint8_t)green;
+                _textureData[pixel + 2] = (uint8_t)blue;
+                _textureData[pixel + 3] = (uint8_t)alpha;
+            }
+        }
+
+        _bandCounters[band] = counters;
+    });
+
+    size_t screenBlockCount = 0;
+
+    for (auto& counters : _bandCounters)
+    {
+        screenBlockCount += counters.blocks;
+        _skyBlocksVisible += counters.skyBlocks;
+        _cavernBlocksVisible += counters.cavernBlocks;
+    }
+
+    return screenBlockCount;
+}
+
+bool Lightmapper::verifyBands()
+{
+    if (!_textureData)
+    {
+        return false;
+    }
+
+    // Split the screen even if this machine has no workers, which still checks that the bands line up
+    auto bandCount = MAX(getBandCount(_screenRect), (size_t)MAX_WORKER_THREADS + 1);
+    computeBands(_screenRect, 1);
+    composeTexture(1);
+    std::vector<uint8_t> expected(_textureData, _textureData + _textureSizeBytes);
+    computeBands(_screenRect, bandCount);
+    composeTexture(bandCount);
+    auto match = memcmp(expected.data(), _textureData, _textureSizeBytes) == 0;
+
+    if (match)
+    {
+        AXLOGI("[Lightmapper] Output of {} bands matches a single band", bandCount);
+    }
+    else
+    {
+        AXLOGW("[Lightmapper] Output of {} bands does not match a single band!", bandCount);
+    }
+
+    return match;
+}
+
+void Lightmapper::computeLight(const Rect& rect)
+{
+    BlockRectRange blocks(_zone, rect);
+
+    if (blocks.isEmpty())
+    {
+        return;
+    }
+
+    auto minX = blocks.getMinX();
+    auto minY = blocks.getMinY();
+    auto maxX = blocks.getMaxX();
+    auto maxY = blocks.getMaxY();
+
+    // Reset state
+    for (auto block : blocks)
     {
         block->setCurrentLightR(0.0F);
         block->setCurrentLightG(0.0F);
         block->setCurrentLightB(0.0F);
         block->setCurrentLightA(0.0F);
         block->setCurrentLightLit(false);
+        block->setCurrentLightSun(getSunlight(block));
     }
 
-    // NOTE: We perform both passes in a single update
-    // 0x100057824: Pass 1 (front lighting & light rings)
-    auto surface = (float)(_zone->getBlocksHeight() >> 2);
+    // Find the light sources that can reach the rect
+    BlockRectRange sourceBlocks(_zone, minX - LIGHT_SOURCE_PADDING, minY - LIGHT_SOURCE_PADDING,
+                                maxX + LIGHT_SOURCE_PADDING, maxY + LIGHT_SOURCE_PADDING);
+    sLightSources.clear();
 
-    for (auto block : _screenBlocks)
+    for (auto block : sourceBlocks)
     {
-        auto x     = block->getX();
-        auto y     = block->getY();
-        auto front = block->getFrontItem();
-        auto light = front->getLight();
-
-        if (light <= 0.0F)
+        if (block->getFrontItem()->getLight() > 0.0F)
         {
-            continue;
+            sLightSources.push_back(block);
         }
+    }
 
+    // 0x100057824: Pass 1 (front lighting & light rings)
+    // NOTE: blocks lit by a source directly are set before any light rings are applied instead of in the same loop.
+    // This gives the same result, except for which source wins when several of them light the same block.
+    for (auto source : sLightSources)
+    {
         // Set block light color
+        auto front        = source->getFrontItem();
         auto& color       = front->getLightColor();
         auto& lightOffset = front->getLightPosition();
-        x += (int16_t)lightOffset.x;
-        y += (int16_t)lightOffset.y;
+        int16_t x         = source->getX() + (int16_t)lightOffset.x;
+        int16_t y         = source->getY() + (int16_t)lightOffset.y;
 
-        if (_screenRect.containsPoint(Point(x, y)))
+        if (x < minX || x > maxX || y < minY || y > maxY)
         {
-            auto block = _zone->getBlockAt(x, y);
+            continue;
+        }
 
-            if (block)
-            {
-                block->setCurrentLightR(color.r);
-                block->setCurrentLightG(color.g);
-                block->setCurrentLightB(color.b);
-                block->setCurrentLightA(light * (block->getLiquid() > 0 ? 0.9F : 1.0F));
-                block->setCurrentLightLit(true);
-            }
-            else
-            {
-                AXLOGW("[Lightmapper] Null block at {} {}", x, y);
-            }
+        if (auto block = findBlockAt(_zone, x, y))
+        {
+            block->setCurrentLightR(color.r);
+            block->setCurrentLightG(color.g);
+            block->setCurrentLightB(color.b);
+            block->setCurrentLightA(front->getLight() * (block->getLiquid() > 0 ? 0.9F : 1.0F));
+            block->setCurrentLightLit(true);
         }
+    }
+
+    for (auto source : sLightSources)
+    {
+        auto front        = source->getFrontItem();
+        auto& color       = front->getLightColor();
+        auto& lightOffset = front->getLightPosition();
+        int16_t x         = source->getX() + (int16_t)lightOffset.x;
+        int16_t y         = source->getY() + (int16_t)lightOffset.y;
 
         // 0x100057CC7: Apply light rings
-        light             = clampf(light, 1.0F, (float)LIGHT_RING_ITERATIONS);
+        auto light        = clampf(front->getLight(), 1.0F, (float)LIGHT_RING_ITERATIONS);
         auto ringCount    = MIN(LIGHT_RING_ITERATIONS, (int)light);
         ssize_t ringIndex = 0;
 
@@ -307,12 +569,12 @@ void Lightmapper::illuminateBlocks(float deltaTime)
                 auto pointX = _lightRings[ringIndex + j * 2] + x;
                 auto pointY = _lightRings[ringIndex + j * 2 + 1] + y;
 
-                if (!_screenRect.containsPoint(Point(pointX, pointY)))
+                if (pointX < minX || pointX > maxX || pointY < minY || pointY > maxY)
                 {
                     continue;
                 }
 
-                auto block = _zone->getBlockAt(pointX, pointY);
+                auto block = findBlockAt(_zone, pointX, pointY);
 
                 if (!block || block->isCurrentLightLit())
                 {
@@ -336,184 +598,199 @@ void Lightmapper::illuminateBlocks(float deltaTime)
         }
     }
 
-    // 0x100057824: Pass 2 (sunlight & liquid lighting)
-    for (auto block : _screenBlocks)
+    for (auto block : blocks)
     {
-        auto x     = block->getX();
-        auto y     = block->getY();
-        auto front = block->getFrontItem();
-
-        // 0x1000578BA: Increment visible base block counter
-        auto base = block->getBase();
-
-        if (base < 2 && !block->isOpaque())
+        // 0x100058425: Apply liquid lighting
+        if (block->getLiquid() > 0)
         {
-            if (base == 0)
-            {
-                _skyBlocksVisible++;
-            }
-            else  // 1 = base/empty
+            auto liquid = block->getLiquidItem();
+            auto light  = liquid->getLight();
+            auto& color = liquid->getLightColor();
+
+            if (light > 0.0F)
             {
-                _cavernBlocksVisible++;
+                block->setCurrentLightR(block->getCurrentLightR() + color.r * 0.25F);
+                block->setCurrentLightG(block->getCurrentLightG() + color.g * 0.25F);
+                block->setCurrentLightB(block->getCurrentLightB() + color.b * 0.25F);
+                block->setCurrentLightA(block->getCurrentLightA() + light * 50.0F);
             }
         }
+    }
+}
 
-        // 0x10005791B: Apply light from sunlight
-        auto light    = 0.0F;
-        auto sunlight = _zone->getSunlightAt(x);
+void Lightmapper::invalidateLight(const Rect& rect)
+{
+    // Blocks off screen are recomputed once they scroll into view
+    auto minX = MAX(rect.getMinX(), _screenRect.getMinX());
+    auto minY = MAX(rect.getMinY(), _screenRect.getMinY());
+    auto maxX = MIN(rect.getMaxX(), _screenRect.getMaxX());
+    auto maxY = MIN(rect.getMaxY(), _screenRect.getMaxY());
+
+    if (minX <= maxX && minY <= maxY)
+    {
+        _dirtyRects.push_back(Rect(minX, minY, maxX - minX, maxY - minY));
+    }
+}
 
-        if (base == 0)
+void Lightmapper::collectDirtyLight()
+{
+    auto minX = (int16_t)_screenRect.getMinX();
+    auto minY = (int16_t)_screenRect.getMinY();
+    auto maxX = (int16_t)_screenRect.getMaxX();
+    auto maxY = (int16_t)_screenRect.getMaxY();
+
+    // Blocks that have scrolled into view
+    if (_litRect.size.width < 0.0F || !_litRect.intersectsRect(_screenRect))
+    {
+        invalidateLight(_screenRect);
+    }
+    else
+    {
+        auto litMinX = (int16_t)_litRect.getMinX();
+        auto litMinY = (int16_t)_litRect.getMinY();
+        auto litMaxX = (int16_t)_litRect.getMaxX();
+        auto litMaxY = (int16_t)_litRect.getMaxY();
+
+        if (minX < litMinX)
         {
-            light = 250.0F;
+            invalidateLight(Rect(minX, minY, litMinX - 1 - minX, maxY - minY));
+        }
 
-            if (sunlight < y && block->getBack() > 0 && !front->isWhole())
-            {
-                auto above = block->getAbove();
+        if (maxX > litMaxX)
+        {
+            invalidateLight(Rect(litMaxX + 1, minY, maxX - litMaxX - 1, maxY - minY));
+        }
 
-                if (above && above->getFrontItem()->isWhole())
-                {
-                    light = 0.0F;
-                }
-            }
+        if (minY < litMinY)
+        {
+            invalidateLight(Rect(minX, minY, maxX - minX, litMinY - 1 - minY));
         }
-        else
+
+        if (maxY > litMaxY)
         {
-            // Get a bit of sunlight from nearby blocks if we can
-            auto width = _zone->getBlocksWidth();
-            auto depth = ((float)y - surface) / (surface * 3.0F);
-            light      = clampf((float)sunlight + 5.0F - y, 0.0F, 5.0F);
-            light      = math_util::lerp(light / 5.0F * 250.0F, 0.0F, depth);
+            invalidateLight(Rect(minX, litMaxY + 1, maxX - minX, maxY - litMaxY - 1));
+        }
+    }
 
-            if (x > 0)
-            {
-                auto adjacentLight = clampf((float)_zone->getSunlightAt(x - 1) + 5.0F - y, 0.0F, 5.0F);
-                light += math_util::lerp(adjacentLight / 5.0F * 150.0F, 0.0F, depth);
+    _litRect = _screenRect;
 
-                if (x > 1)
-                {
-                    auto adjacentLight = clampf((float)_zone->getSunlightAt(x - 2) + 5.0F - y, 0.0F, 5.0F);
-                    light += math_util::lerp(adjacentLight / 5.0F * 75.0F, 0.0F, depth);
-                }
-            }
+    // Columns whose sunlight depth has changed, plus the columns next to them that get some of their sunlight
+    auto width = _zone->getBlocksWidth();
 
-            if (x + 1 < width)
-            {
-                auto adjacentLight = clampf((float)_zone->getSunlightAt(x + 1) + 5.0F - y, 0.0F, 5.0F);
-                light += math_util::lerp(adjacentLight / 5.0F * 150.0F, 0.0F, depth);
+    if (_sunlightCache.size() != (size_t)width)
+    {
+        _sunlightCache.assign(width, INT16_MIN);
+    }
 
-                if (x + 2 < width)
-                {
-                    auto adjacentLight = clampf((float)_zone->getSunlightAt(x + 2) + 5.0F - y, 0.0F, 5.0F);
-                    light += math_util::lerp(adjacentLight / 5.0F * 75.0F, 0.0F, depth);
-                }
-            }
+    int16_t sunlightMinX = width;
+    int16_t sunlightMaxX = -1;
+
+    for (int16_t x = MAX(minX - 2, 0); x <= MIN(maxX + 2, width - 1); x++)
+    {
+        auto sunlight = _zone->getSunlightAt(x);
+
+        if (sunlight != _sunlightCache[x])
+        {
+            _sunlightCache[x] = sunlight;
+            sunlightMinX      = MIN(sunlightMinX, x);
+            sunlightMaxX      = MAX(sunlightMaxX, x);
         }
+    }
+
+    if (sunlightMinX <= sunlightMaxX)
+    {
+        invalidateLight(Rect(sunlightMinX - 2, minY, sunlightMaxX - sunlightMinX + 4, maxY - minY));
+    }
 
-        light = clampf(light, 0.0F, 255.0F);
+    // Blocks that have changed; changes to light sources affect every block their light can reach
+    auto chunkWidth  = _zone->getChunkWidth();
+    auto chunkHeight = _zone->getChunkHeight();
+    auto padding     = Vec2::ONE * LIGHT_SOURCE_PADDING;
 
-        // 0x100058425: Apply liquid lighting
-        if (block->getLiquid() > 0)
+    for (auto chunkY = MAX(minY - LIGHT_SOURCE_PADDING, 0) / chunkHeight;
+         chunkY <= (maxY + LIGHT_SOURCE_PADDING) / chunkHeight; chunkY++)
+    {
+        for (auto chunkX = MAX(minX - LIGHT_SOURCE_PADDING, 0) / chunkWidth;
+             chunkX <= (maxX + LIGHT_SOURCE_PADDING) / chunkWidth; chunkX++)
         {
-            auto liquid = block->getLiquidItem();
-            auto light  = liquid->getLight();
-            auto& color = liquid->getLightColor();
+            auto chunk = _zone->getChunkAt(chunkX, chunkY);
 
-            if (light > 0.0F)
+            if (chunk && chunk->isLightDirty())
             {
-                block->setCurrentLightR(block->getCurrentLightR() + color.r * 0.25F);
-                block->setCurrentLightG(block->getCurrentLightG() + color.g * 0.25F);
-                block->setCurrentLightB(block->getCurrentLightB() + color.b * 0.25F);
-                block->setCurrentLightA(block->getCurrentLightA() + light * 50.0F);
+                auto rect = chunk->getLightDirtyRect();
+                invalidateLight(Rect(rect.origin - padding, rect.size + padding * 2.0F));
+                chunk->clearLightDirty();
             }
         }
+    }
+}
 
-        auto red        = block->getCurrentLightR();
-        auto green      = block->getCurrentLightG();
-        auto blue       = block->getCurrentLightB();
-        auto alpha      = clampf(getBaseLight() - block->getCurrentLightA(), 0.0F, 255.0F);
-        auto thunder    = _zone->getWorldRenderer()->getSky()->getThunder();
-        auto cloudCover = _zone->getCloudCover() * -0.4F + 1.0F;
-        cloudCover      = math_util::lerp(cloudCover, 1.0F, thunder);
-        auto daylight   = math_util::lerp(_zone->getDayPercent(), 1.0F, thunder);
-        alpha -= math_util::lerp(light * cloudCover * daylight, 255.0F, _flash);
-
-        // 0x10005866B: Apply pulsating glow effect
-        // FIXME: take light position into account
-        if (front->getLight() > 0.0F)
-        {
-            auto offset = math_util::lerp(4.0F, 7.0F, (float)x / y);
-            auto glow   = sinf(offset * ((float)y + x + GameManager::getInstance()->getElapsedTime())) * 10.0F + 10.0F;
-            red -= glow;
-            green -= glow;
-            blue -= glow;
-        }
+float Lightmapper::getSunlight(BaseBlock* block) const
+{
+    auto x       = block->getX();
+    auto y       = block->getY();
+    auto front   = block->getFrontItem();
+    auto base    = block->getBase();
+    auto surface = (float)(_zone->getBlocksHeight() >> 2);
 
-        // 0x10005873E: Show field damage radius
-#if RESTRICT_FIELD_DAMAGE_AURA
-        if (_zone->getBiomeType() == Biome::HELL)
-#endif
+    // 0x10005791B: Apply light from sunlight
+    auto light    = 0.0F;
+    auto sunlight = _zone->getSunlightAt(x);
+
+    if (base == 0)
+    {
+        light = 250.0F;
+
+        if (sunlight < y && block->getBack() > 0 && !front->isWhole())
         {
-            auto fieldDamageBlock = _zone->getFieldDamageBlock();
+            auto above = findBlockAt(_zone, x, y - 1);
 
-            if (fieldDamageBlock)
+            if (above && above->getFrontItem()->isWhole())
             {
-                auto& color    = fieldDamageBlock->getItem()->getColor();
-                auto distance  = math_util::getDistance(x, y, fieldDamageBlock->getX(), fieldDamageBlock->getY());
-                auto intensity = distance / -50.0F + 1.0F;
-                red            = math_util::lerp(red, color.r, intensity);
-                green          = math_util::lerp(green, color.g, intensity);
-                blue           = math_util::lerp(blue, color.b, intensity);
+                light = 0.0F;
             }
         }
+    }
+    else
+    {
+        // Get a bit of sunlight from nearby blocks if we can
+        auto width = _zone->getBlocksWidth();
+        auto depth = ((float)y - surface) / (surface * 3.0F);
+        light      = clampf((float)sunlight + 5.0F - y, 0.0F, 5.0F);
+        light      = math_util::lerp(light / 5.0F * 250.0F, 0.0F, depth);
 
-        // 0x100058845: Apply overlay (haze)
-        auto overlay      = MAX(_overlay, _deathOverlay);
-        auto overlayColor = Player::getMain()->getHealth() <= 0.0F ? kDeathOverlayColor : kOverlayColor;
-
-        if (overlay > 0.0F)
+        if (x > 0)
         {
-            red   = math_util::lerp(red, overlayColor.r, overlay);
-            green = math_util::lerp(green, overlayColor.g, overlay);
-            blue  = math_util::lerp(blue, overlayColor.b, overlay);
-            alpha = math_util::lerp(alpha, overlayColor.a, overlay);
-        }
-
-        red   = clampf(red, 0.0F, 255.0F);
-        green = clampf(green, 0.0F, 255.0F);
-        blue  = clampf(blue, 0.0F, 255.0F);
-        alpha = clampf(alpha, 0.0F, 255.0F);
+            auto adjacentLight = clampf((float)_zone->getSunlightAt(x - 1) + 5.0F - y, 0.0F, 5.0F);
+            light += math_util::lerp(adjacentLight / 5.0F * 150.0F, 0.0F, depth);
 
-        // 0x100058A72: Set pixel in texture
-        auto pixelX = (ssize_t)(floor(x - _ul.x));
-        auto pixelY = (ssize_t)(floor(y - _ul.y));
-        auto pixel  = (pixelY * _textureWidth + pixelX) * 4;
+            if (x > 1)
+            {
+                auto adjacentLight = clampf((float)_zone->getSunlightAt(x - 2) + 5.0F - y, 0.0F, 5.0F);
+                light += math_util::lerp(adjacentLight / 5.0F * 75.0F, 0.0F, depth);
+            }
+        }
 
-        // FIXME: This CAN happen, and while it *shouldn't* really matter, it'd be better if it didn't.
-        if (pixel >= 0 && pixel + 3 < _textureSizeBytes)
+        if (x + 1 < width)
         {
-            _textureData[pixel]     = (uint8_t)red;
-            _textureData[pixel + 1] = (uint8_t)green;
-            _textureData[pixel + 2] = (uint8_t)blue;
-            _textureData[pixel + 3] = (uint8_t)alpha;
+            auto adjacentLight = clampf((float)_zone->getSunlightAt(x + 1) + 5.0F - y, 0.0F, 5.0F);
+            light += math_util::lerp(adjacentLight / 5.0F * 150.0F, 0.0F, depth);
+
+            if (x + 2 < width)
+            {
+                auto adjacentLight = clampf((float)_zone->getSunlightAt(x + 2) + 5.0F - y, 0.0F, 5.0F);
+                light += math_util::lerp(adjacentLight / 5.0F * 75.0F, 0.0F, depth);
+            }
         }
     }
 
-    _texture->updateWithData(_textureData, _textureSizeBytes, backend::PixelFormat::RGBA8, backend::PixelFormat::RGBA8,
-                             _textureWidth, _textureHeight, false);
-    MathUtil::smooth(&_flash, 0.0F, deltaTime * 3.0F, 0.1F);
-
-    if (_flash < 0.01F)
-    {
-        _flash = 0.01F;
-    }
+    return clampf(light, 0.0F, 255.0F);
+}
 
-    // 0x100058BB3: Update sky coverage & visibility
-    // FIXME: There's somewhat of an inaccuracy caused by the padding used by the lightmapper
-    auto biomeType   = _zone->getBiomeType();
-    auto skyCoverage = clampf((float)_skyBlocksVisible / _screenBlocks.size(), 0.0F, 1.0F);
-    _zone->setSkyCoverage(skyCoverage);
-    _skyVisible    = _skyBlocksVisible > 0 || biomeType == Biome::SPACE;
-    _cavernVisible = !_skyVisible && _cavernBlocksVisible > 0 && biomeType != Biome::SPACE;
+size_t Lightmapper::getBandCount(const Rect& rect) const
+{
+    auto rows = (size_t)rect.size.height + 1;
+    return std::clamp(rows / MIN_BAND_ROWS, (size_t)1, _threadPool->getThreadCount());
 }
 
 float Lightmapper::getBaseLight() const
@@ -11,6 +11,7 @@ namespace opendw
 class BaseBlock;
 class Item;
 class Player;
+class ThreadPool;
 class WorldZone;
 
 /*
@@ -40,6 +41,24 @@ public:
     /* FUNC: Lightmapper::illuminateBlocks: @ 0x10005707D */
     void illuminateBlocks(float deltaTime);
 
+    /*
+     * Recomputes the cached light of all blocks within the specified block rect.
+     * Light from emitters and liquids and the amount of sunlight are cached per block, because they only change when
+     * blocks or sunlight change. Everything that changes over time is applied on top of it in illuminateBlocks.
+     * Only blocks within the rect are written to, so rects that don't overlap can be computed on separate threads.
+     */
+    void computeLight(const ax::Rect& rect);
+
+    /* Queues the blocks within the specified block rect to have their cached light recomputed. */
+    void invalidateLight(const ax::Rect& rect);
+
+    /*
+     * Debug check for the banded light passes. Lights the screen once as a single band and once split into several
+     * bands, then compares the texture data of both byte for byte. Nothing is uploaded until the next update.
+     * @return Whether the output of both runs is identical.
+     */
+    bool verifyBands();
+
     /* FUNC: Lightmapper::baseLight @ 0x100058E07 */
     float getBaseLight() const;
 
@@ -67,6 +86,32 @@ public:
     void onPlayerAccessoriesChanged(Player* player);
 
 private:
+    /* Queues everything whose cached light has gone out of date since the last update. */
+    void collectDirtyLight();
+
+    /* @return The amount of sunlight that reaches the specified block. */
+    float getSunlight(BaseBlock* block) const;
+
+    /* Runs computeLight on the specified number of horizontal bands of a block rect. */
+    void computeBands(const ax::Rect& rect, size_t bandCount);
+
+    /*
+     * Writes the light of every block on screen to the texture data, split into the specified number of bands.
+     * @return The number of blocks on screen.
+     */
+    size_t composeTexture(size_t bandCount);
+
+    /* @return The number of horizontal bands that work on the specified block rect is split into. */
+    size_t getBandCount(const ax::Rect& rect) const;
+
+    /* Visible block counts of a single band, added together once all bands are done. */
+    struct BandCounters
+    {
+        size_t blocks;
+        ssize_t skyBlocks;
+        ssize_t cavernBlocks;
+    };
+
     WorldZone* _zone;              // Lightmapper::zone @ 0x100311610
     ax::Sprite* _torchLight;       // Lightmapper::torchLight @ 0x100311650
     int8_t* _lightRings;           // Lightmapper::lightRings @ 0x100311670
@@ -92,8 +137,12 @@ private:
     float _previousWorldScale;
     Item* _torchAccessory;
     ax::Rect _screenRect;
-    std::vector<BaseBlock*> _screenBlocks;
     ax::ProgramState* _programState;
+    ax::Rect _litRect;                    // Screen rect of the previous update, whose light is known to be up to date
+    std::vector<ax::Rect> _dirtyRects;    // Block rects queued for computeLight
+    std::vector<int16_t> _sunlightCache;  // Sunlight depth per column as of the previous update
+    std::vector<BandCounters> _bandCounters;
+    ThreadPool* _threadPool;
 };
 
 }  // namespace opendw
@@ -2,8 +2,10 @@
 
 #include "base/Item.h"
 #include "base/Player.h"
+#include "graphics/WorldRenderer.h"
 #include "gui/GameGui.h"
 #include "util/MapUtil.h"
+#include "util/MathUtil.h"
 #include "zone/MetaBlock.h"
 #include "zone/WorldZone.h"
 #include "CommonDefs.h"
@@ -24,78 +26,132 @@ static const Color3B kNeutralFieldColor    = {0xFF, 0xFF, 0xFF};
 
 void VectorLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-    clear();
+    // Leave the draw node alone entirely while there is nothing on screen to draw
+    if (!_empty)
+    {
+        clear();
+        _empty = true;
+    }
 
     // TODO: check if teleport is active
     // TODO: draw lines between energy particles
 
     // 0x1000FC648: Draw field radii
-    auto time    = GameManager::getInstance()->getElapsedTime();
-    auto solid   = GameGui::getMain()->isProtectorRangeVisible();
-    auto zone    = WorldZone::getMain();
-    auto& blocks = zone->getFieldDisplayMetaBlocks();
+    auto time         = GameManager::getInstance()->getElapsedTime();
+    auto solid        = GameGui::getMain()->isProtectorRangeVisible();
+    auto zone         = WorldZone::getMain();
+    auto& visibleRect = WorldRenderer::getMain()->getVisibleRect();
+    auto& blocks      = zone->getFieldDisplayMetaBlocks();
 
     for (auto&& entry : blocks)
     {
-        auto block  = entry.second;
-        auto item   = block->getItem();
-        auto offset = Vec2(item->getWidth() - 1, item->getHeight() - 1) * 0.5F * BLOCK_SIZE;
-        auto point  = zone->getPointAtBlock((int16_t)block->getX(), (int16_t)block->getY()) + offset;
+        auto block    = entry.second;
+        auto item     = block->getItem();
+        auto display  = item->isUsableType(UseType::FIELD_DISPLAY);
+        auto minigame = item->isUsableType(UseType::MINIGAME);
+        auto suppress = item->isUsableType(UseType::SUPPRESS);
+        auto field    = display ? (suppress ? item->getPower() : item->getField()) : 0.0F;
+        auto range    = minigame ? map_util::getFloat(block->getMetadata(), "r") : 0.0F;
+        auto offset   = Vec2(item->getWidth() - 1, item->getHeight() - 1) * 0.5F * BLOCK_SIZE;
+        auto point    = zone->getPointAtBlock((int16_t)block->getX(), (int16_t)block->getY()) + offset;
+
+        // Skip fields that can't reach the screen
+        auto reach = MAX(field, range + 0.1F) * BLOCK_SIZE * 2.0F;
+
+        if (!math_util::growRect(visibleRect, Size(reach, reach)).containsPoint(point))
+        {
+            continue;
+        }
 
         // 0x1000FC8AC: Draw protective/suppressive field radius
-        if (item->isUsableType(UseType::FIELD_DISPLAY))
+        if (display && field > 0.0F)
         {
-            auto suppress = item->isUsableType(UseType::SUPPRESS);
-            auto field    = suppress ? item->getPower() : item->getField();
+            auto radius = solid ? (field - 0.01F) : fmodf(time * FIELD_SPEED, field * 5.0F);
 
-            if (field > 0.0F)
+            if (radius > 0.0F && radius < field)
             {
-                auto radius = solid ? (field - 0.01F) : fmodf(time * FIELD_SPEED, field * 5.0F);
+                auto friendly = block->isOwnedByPlayerOrFollower();
+                auto color    = suppress ? kSuppressorFieldColor : friendly ? kFriendlyFieldColor : kNeutralFieldColor;
 
-                if (radius > 0.0F && radius < field)
+                if (solid)
                 {
-                    auto friendly = block->isOwnedByPlayerOrFollower();
-                    auto color = suppress ? kSuppressorFieldColor : friendly ? kFriendlyFieldColor : kNeutralFieldColor;
-
-                    if (solid)
+                    auto alpha = (sinf(time * 8.0F) * 0.125F + 0.75F) * 0.125F;
+                    drawCachedCircle(point, radius * BLOCK_SIZE, 100, true, Color4F(color, alpha));
+                }
+                else
+                {
+                    auto alpha = (1.0F - radius / field) * 0.44F;
+                    drawCachedCircle(point, radius * BLOCK_SIZE, 100, false, Color4F(color, alpha));
+#if DRAW_INNER_RING
+                    if (radius > 0.5F)
                     {
-                        auto alpha = (sinf(time * 8.0F) * 0.125F + 0.75F) * 0.125F;
-                        drawSolidCircle(point, radius * BLOCK_SIZE, 0.0F, 100, Color4F(color, alpha));
+                        drawCachedCircle(point, (radius - 0.5F) * BLOCK_SIZE, 120, false, Color4F(color, alpha));
                     }
-                    else
-                    {
-                        auto alpha = (1.0F - radius / field) * 0.44F;
-                        drawCircle(point, radius * BLOCK_SIZE, 0.0F, 100, false, Color4F(color, alpha));
-#if DRAW_INNER_RING
-                        if (radius > 0.5F)
-                        {
-                            drawCircle(point, (radius - 0.5F) * BLOCK_SIZE, 0.0F, 120, false, Color4F(color, alpha));
-                        }
 #endif  // DRAW_INNER_RING
-                    }
                 }
             }
         }
 
         // 0x1000FC930: Draw minigame field radius
-        if (item->isUsableType(UseType::MINIGAME))
+        if (minigame && range > 0.0F)
         {
-            auto range = map_util::getFloat(block->getMetadata(), "r");
+            auto radius = range + rand_0_1() * 0.1F;
+            drawCachedCircle(point, radius * BLOCK_SIZE, random(100, 120), false, Color4F(kMinigameRangeColor, 0.8F));
+            drawCachedCircle(point, (radius - 0.05F) * BLOCK_SIZE, random(100, 120), false,
+                             Color4F(kMinigameRangeColor, 0.6F));
+            drawCachedCircle(point, (radius - 0.1F) * BLOCK_SIZE, random(100, 120), false,
+                             Color4F(kMinigameRangeColor, 0.5F));
+        }
+    }
 
-            if (range > 0.0F)
-            {
-                auto radius = range + rand_0_1() * 0.1F;
-                drawCircle(point, radius * BLOCK_SIZE, 0.0F, random(100, 120), false,
-                           Color4F(kMinigameRangeColor, 0.8F));
-                drawCircle(point, (radius - 0.05F) * BLOCK_SIZE, 0.0F, random(100, 120), false,
-                           Color4F(kMinigameRangeColor, 0.6F));
-                drawCircle(point, (radius - 0.1F) * BLOCK_SIZE, 0.0F, random(100, 120), false,
-                           Color4F(kMinigameRangeColor, 0.5F));
-            }
+    if (!_empty)
+    {
+        DrawNode::draw(renderer, transform, flags);
+    }
+}
+
+void VectorLayer::drawCachedCircle(const Vec2& center,
+                                   float radius,
+                                   unsigned int segments,
+                                   bool solid,
+                                   const Color4F& color)
+{
+    auto& unitCircle = getUnitCircle(segments);
+    _circlePoints.resize(segments);
+
+    for (unsigned int i = 0; i < segments; i++)
+    {
+        _circlePoints[i] = center + unitCircle[i] * radius;
+    }
+
+    if (solid)
+    {
+        drawSolidPoly(_circlePoints.data(), segments, color);
+    }
+    else
+    {
+        drawPoly(_circlePoints.data(), segments, true, color);
+    }
+
+    _empty = false;
+}
+
+const std::vector<Vec2>& VectorLayer::getUnitCircle(unsigned int segments)
+{
+    auto& points = _unitCircles[segments];
+
+    if (points.empty())
+    {
+        points.resize(segments);
+        auto step = 2.0F * (float)M_PI / segments;
+
+        for (unsigned int i = 0; i < segments; i++)
+        {
+            points[i] = Vec2(cosf(step * i), sinf(step * i));
         }
     }
 
-    DrawNode::draw(renderer, transform, flags);
+    return points;
 }
 
 }  // namespace opendw
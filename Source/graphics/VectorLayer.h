@@ -19,6 +19,21 @@ public:
 
     /* FUNC: VectorLayer::draw @ 0x1000FBF68 */
     void draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags) override;
+
+    /* Same as drawCircle and drawSolidCircle, but reuses the tessellation of earlier circles with as many segments. */
+    void drawCachedCircle(const ax::Vec2& center,
+                          float radius,
+                          unsigned int segments,
+                          bool solid,
+                          const ax::Color4F& color);
+
+private:
+    /* @return The points of a circle with a radius of 1 and the specified number of segments. */
+    const std::vector<ax::Vec2>& getUnitCircle(unsigned int segments);
+
+    std::unordered_map<unsigned int, std::vector<ax::Vec2>> _unitCircles;
+    std::vector<ax::Vec2> _circlePoints;  // Scratch buffer for drawCachedCircle
+    bool _empty = true;                   // Whether nothing has been drawn since the last clear
 };
 
 }  // namespace opendw
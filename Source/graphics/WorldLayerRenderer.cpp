@@ -3,8 +3,10 @@
 #include "base/GameConfig.h"
 #include "base/Item.h"
 #include "base/ItemCodes.h"
+#include "graphics/backend/MaskedQuadMesh.h"
 #include "graphics/backend/MaskedSprite.h"
 #include "graphics/backend/MaskedSpriteBatchNode.h"
+#include "graphics/DebrisSystem.h"
 #include "graphics/WorldRenderer.h"
 #include "gui/widget/MultiLabel.h"
 #include "util/ColorUtil.h"
@@ -16,6 +18,8 @@
 #include "CommonDefs.h"
 #include "GameManager.h"
 
+#define MESH_CELL_TOLERANCE 1.0F  // How far a baked sprite may stick out of its block due to rounding
+
 USING_NS_AX;
 
 namespace opendw
@@ -46,6 +50,8 @@ bool WorldLayerRenderer::initWithLayer(BlockLayer layer, MaskedSpriteBatchNode*
     _zone                  = GameManager::getInstance()->getZone();
     _placeBackgroundsInAlt = false;
     _biomeRenderer         = false;
+    _meshEnabled           = false;
+    _debrisSystem          = nullptr;
     auto cache             = SpriteFrameCache::getInstance();
     _shadowShallowFrame    = cache->getSpriteFrameByName("borders/whole-shadow");
     _shadowDeepFrame       = cache->getSpriteFrameByName("borders/earth-deep");
@@ -57,6 +63,11 @@ bool WorldLayerRenderer::initWithLayer(BlockLayer layer, MaskedSpriteBatchNode*
 
 void WorldLayerRenderer::clear()
 {
+    if (_debrisSystem)
+    {
+        _debrisSystem->clear();
+    }
+
     if (_biomeRenderer)
     {
         _recycledSprites.clear();
@@ -65,6 +76,13 @@ void WorldLayerRenderer::clear()
         return;
     }
 
+    for (auto& [chunk, mesh] : _meshes)
+    {
+        removeChild(mesh);
+    }
+
+    _meshes.clear();
+
     // NOTE: we can (safely) assume that sprites are already recycled by the chunk recycler
     /* for (auto& child : _batchNode->getChildren())
     {
@@ -1174,6 +1192,11 @@ MaskedSprite* WorldLayerRenderer::placeSprite(BaseBlock* block,
     sprite->setFlippedX(flipX);
     sprite->setVisible(true);
 
+    if (_layer == BlockLayer::LIQUID)
+    {
+        trackSprite(sprite);
+    }
+
     if (sprite->getLocalZOrder() != z)
     {
         _batchNode->reorderChild(sprite, z);
@@ -1240,6 +1263,106 @@ void WorldLayerRenderer::recycleSprite(MaskedSprite* sprite)
 
     sprite->setVisible(false);
     _recycledSprites.pushBack(sprite);
+    untrackSprite(sprite);
+}
+
+void WorldLayerRenderer::trackSprite(MaskedSprite* sprite)
+{
+    if (_trackedSpriteIndices.emplace(sprite, _trackedSprites.size()).second)
+    {
+        _trackedSprites.push_back(sprite);
+    }
+}
+
+void WorldLayerRenderer::untrackSprite(MaskedSprite* sprite)
+{
+    auto it = _trackedSpriteIndices.find(sprite);
+
+    if (it == _trackedSpriteIndices.end())
+    {
+        return;
+    }
+
+    // Swap with the last sprite to keep the list dense
+    auto index = it->second;
+    auto last  = _trackedSprites.back();
+    _trackedSprites[index]      = last;
+    _trackedSpriteIndices[last] = index;
+    _trackedSprites.pop_back();
+    _trackedSpriteIndices.erase(sprite);
+}
+
+bool WorldLayerRenderer::canBakeSprite(BaseBlock* block, MaskedSprite* sprite)
+{
+    if (!_meshEnabled || sprite->getParent() != _batchNode || !sprite->isVisible() || sprite->getTag() != 0 ||
+        sprite->getNumberOfRunningActions() > 0 || !sprite->getChildren().empty() ||
+        sprite->getLocalZOrder() > MESH_MAX_Z)
+    {
+        return false;
+    }
+
+    // Leave sprites of items that are touched up by WorldRenderer::processEffects or special placement
+    auto item = block->getItemForLayer(_layer);
+
+    if (!item || item->getGlow() > 0.0F || !item->getSpriteAnimation().empty() ||
+        !item->getSpriteContinuityAnimation().empty() || item->getSpecialPlacement() != SpecialPlacement::NONE)
+    {
+        return false;
+    }
+
+    // Meshes only sort quads within their own chunk and draw below the batch node, so only sprites that stay inside
+    // their own block can be baked without changing the order in which they overlap anything else
+    sprite->updateTransform();
+    auto& quad   = sprite->getMaskedQuad();
+    auto center  = block->getWorldPosition();
+    auto reach   = BLOCK_SIZE * 0.5F + MESH_CELL_TOLERANCE;
+    auto inBlock = [&](const Vec3& position) {
+        return fabsf(position.x - center.x) <= reach && fabsf(position.y - center.y) <= reach;
+    };
+
+    return inBlock(quad.tl.position) && inBlock(quad.bl.position) && inBlock(quad.tr.position) &&
+           inBlock(quad.br.position);
+}
+
+bool WorldLayerRenderer::bakeSprite(BaseBlock* block, MaskedSprite* sprite)
+{
+    if (!canBakeSprite(block, sprite))
+    {
+        return false;
+    }
+
+    auto& mesh = _meshes[block->getChunk()];
+
+    if (!mesh)
+    {
+        mesh = MaskedQuadMesh::createWithBatchNode(_batchNode);
+        addChild(mesh, -1);  // Below the batch node
+    }
+
+    mesh->addQuad(block->getSlot(), sprite->getMaskedQuad(), sprite->getLocalZOrder());
+    recycleSprite(sprite);
+    return true;
+}
+
+DebrisSystem* WorldLayerRenderer::getDebrisSystem()
+{
+    if (!_debrisSystem)
+    {
+        _debrisSystem = DebrisSystem::createWithBatchNode(_batchNode);
+        addChild(_debrisSystem, 1);  // Above the batch node
+    }
+
+    return _debrisSystem;
+}
+
+void WorldLayerRenderer::removeBakedQuads(BaseBlock* block)
+{
+    auto it = _meshes.find(block->getChunk());
+
+    if (it != _meshes.end())
+    {
+        it->second->removeQuads(block->getSlot());
+    }
 }
 
 }  // namespace opendw
@@ -9,8 +9,11 @@ namespace opendw
 {
 
 class BaseBlock;
+class DebrisSystem;
+class MaskedQuadMesh;
 class MaskedSprite;
 class MaskedSpriteBatchNode;
+class WorldChunk;
 class WorldRenderer;
 class WorldZone;
 enum class BlockLayer : uint8_t;
@@ -80,6 +83,28 @@ public:
 
     void recycleSprite(MaskedSprite* sprite);
 
+    /*
+     * @return Whether a sprite of the specified block can be baked. Sprites that may still change after placement,
+     * that stick out of their block or that are above MESH_MAX_Z are left alone.
+     */
+    bool canBakeSprite(BaseBlock* block, MaskedSprite* sprite);
+
+    /*
+     * Copies a sprite of the specified block into the static mesh of its chunk and recycles it.
+     * @return Whether the sprite was baked.
+     */
+    bool bakeSprite(BaseBlock* block, MaskedSprite* sprite);
+
+    /* Removes all quads that were baked for the specified block. */
+    void removeBakedQuads(BaseBlock* block);
+
+    /* @return The particle system for debris of sprites in this renderer. Created when it is first needed. */
+    DebrisSystem* getDebrisSystem();
+
+    /* Enables baking static sprites into per-chunk meshes. */
+    void setMeshEnabled(bool enabled) { _meshEnabled = enabled; }
+    bool isMeshEnabled() const { return _meshEnabled; }
+
     /* FUNC: WorldLayerRenderer::addAltRenderer: @ 0x1000A3971 */
     void addAltRenderer(WorldLayerRenderer* renderer) { _altRenderers.push_back(renderer); }
 
@@ -100,11 +125,20 @@ public:
 
     size_t getRecycledSpriteCount() { return _recycledSprites.size(); }
 
+    /* @return The sprites currently placed by this renderer. Only tracked for liquids, which animate all of them. */
+    const std::vector<MaskedSprite*>& getTrackedSprites() const { return _trackedSprites; }
+
     // Sprite tags
     static constexpr auto ANIMATED_SPRITE_TAG = 0x2F;
     static constexpr auto ACTION_SPRITE_TAG   = 0x30;
 
+    // Highest z of sprites that may be baked; borders, shadows and corners above it always stay in the batch node
+    static constexpr auto MESH_MAX_Z = 4;
+
 private:
+    void trackSprite(MaskedSprite* sprite);
+    void untrackSprite(MaskedSprite* sprite);
+
     inline static size_t sTotalSpriteCount;  // 0x10032EB28
 
     BlockLayer _layer;                               // WorldLayerRenderer::layer @ 0x100312698
@@ -118,6 +152,11 @@ private:
     ax::SpriteFrame* _shadowDeepFrame;               // WorldLayerRenderer::shadowDeepCode @ 0x1003126F0
     ax::Rect _shadowDeepSideMask;                    // WorldLayerRenderer::shdowDeepSideMask @ 0x1003126F8
     ax::Rect _zeroMask;                              // WorldLayerRenderer::zeroMask @ 0x1003126C8
+    std::unordered_map<WorldChunk*, MaskedQuadMesh*> _meshes;
+    std::vector<MaskedSprite*> _trackedSprites;
+    std::unordered_map<MaskedSprite*, size_t> _trackedSpriteIndices;  // Position of each sprite in _trackedSprites
+    bool _meshEnabled;
+    DebrisSystem* _debrisSystem;  // Weak ref, owned as child
 };
 
 }  // namespace opendw
@@ -12,6 +12,7 @@
 #include "graphics/backend/MaskedSpriteBatchNode.h"
 #include "graphics/CavernRenderer.h"
 #include "graphics/Debris.h"
+#include "graphics/DebrisSystem.h"
 #include "graphics/Lightmapper.h"
 #include "graphics/SkyRenderer.h"
 #include "graphics/VectorLayer.h"
@@ -25,6 +26,8 @@
 #include "util/ColorUtil.h"
 #include "util/MathUtil.h"
 #include "zone/BaseBlock.h"
+#include "zone/BlockRectRange.h"
+#include "zone/WorldChunk.h"
 #include "zone/WorldZone.h"
 #include "AudioManager.h"
 #include "CommonDefs.h"
@@ -70,12 +73,14 @@ bool WorldRenderer::initWithZone(WorldZone* zone)
         return false;
     }
 
-    _zone            = zone;
-    _worldScale      = 1.0F;
-    _nextFX          = 0.0F;
-    _fxFrame         = 0;
-    _nextLiquidCycle = 0.0F;
-    _liquidFrame     = 0;
+    _zone                    = zone;
+    _worldScale              = 1.0F;
+    _nextFX                  = 0.0F;
+    _fxFrame                 = 0;
+    _nextLiquidCycle         = 0.0F;
+    _liquidFrame             = 0;
+    _liquidFrames            = {};
+    _blocksRenderedLastFrame = 0;
 
     // Create background
     _background = Node::create();
@@ -275,6 +280,8 @@ void WorldRenderer::clear()
     _explosion  = 0.0F;
     _sky->clear();
     _cavern->clear();
+
+    _renderQueue.forEach([](BaseBlock* block) { block->setQueued(false); });
     _renderQueue.clear();
 
     for (auto& child : _foreground->getChildren())
@@ -317,26 +324,17 @@ void WorldRenderer::update(float deltaTime)
     // 0x10007EB28: Update liquid animation
     if (utils::gettime() >= _nextLiquidCycle)
     {
-        for (auto& child : _liquidBlocksNode->getBatchNode()->getChildren())
-        {
-            if (!child->isVisible())
-            {
-                continue;
-            }
-
-            auto sprite = static_cast<MaskedSprite*>(child);
-            auto tag    = sprite->getTag();
-            auto liquid = tag & 0xFF;
+        auto frameIndex = _liquidFrame % LIQUID_FRAME_COUNT;
 
-            if (liquid == 0)
+        for (auto sprite : _liquidBlocksNode->getTrackedSprites())
+        {
+            if (!sprite->isVisible())
             {
                 continue;
             }
 
-            auto item = GameManager::getInstance()->getConfig()->getItemForCode(liquid);
-            AX_ASSERT(item);
-            auto frame = SpriteFrameCache::getInstance()->getSpriteFrameByName(std::format(
-                "{}-{}", item->getName(), (_liquidFrame % 3) + 1));  // TODO: precomputing may speed things up
+            auto tag   = sprite->getTag();
+            auto frame = _liquidFrames[tag & 0xFF][frameIndex];
 
             if (!frame)
             {
@@ -358,26 +356,33 @@ void WorldRenderer::update(float deltaTime)
 
     // 0x10007EFE8: Update game objects
     // TODO: there's a lot more going on here...
-    for (auto body : _zone->getSpace()->getBodies())
+    for (auto entity : _zone->getLiveEntities())
     {
-        if (body->getType() == CP_BODY_TYPE_STATIC)
+        auto body = entity->getPhysical()->getBody();
+
+        // Block entities share the static body of the space, and entities without a size have no body at all
+        if (!body || body->getType() == CP_BODY_TYPE_STATIC)
         {
             continue;
         }
 
-        if (auto entity = dynamic_cast<Entity*>(body->getUserData()))
-        {
-            auto& contentSize = entity->getContentSize();
-            auto size         = MAX(contentSize.x, contentSize.y) * 2.0F;  // HACK: Overcompensate for rotation
-            auto rect         = math_util::growRect(_visibleRect, {size, size});
-            auto onscreen     = rect.containsPoint(body->getPosition());
-            entity->updateOnscreen(deltaTime, onscreen);
-        }
-        else
+        auto& contentSize = entity->getContentSize();
+        auto size         = MAX(contentSize.x, contentSize.y) * 2.0F;  // HACK: Overcompensate for rotation
+        auto rect         = math_util::growRect(_visibleRect, {size, size});
+        auto onscreen     = rect.containsPoint(body->getPosition());
+        entity->updateOnscreen(deltaTime, onscreen);
+    }
+
+    // Emitter particles are the only other objects with dynamic bodies
+    for (ssize_t i = 0; i < _freeDebrisIndex; i++)
+    {
+        auto debris = _debrisPool[i];
+
+        if (debris->isActive())
         {
-            auto node = static_cast<Node*>(body->getUserData());
-            node->setPosition(body->getPosition());
-            node->setRotation(MATH_RAD_TO_DEG(body->getAngle()));
+            auto body = debris->getPhysical()->getBody();
+            debris->setPosition(body->getPosition());
+            debris->setRotation(MATH_RAD_TO_DEG(body->getAngle()));
         }
     }
 
@@ -479,6 +484,31 @@ void WorldRenderer::loadBiome(const std::string& biome)
             renderer->getBatchNode()->setTexture(texture);
         }
     }
+
+    loadLiquidFrames();
+}
+
+void WorldRenderer::loadLiquidFrames()
+{
+    auto config = GameManager::getInstance()->getConfig();
+    auto cache  = SpriteFrameCache::getInstance();
+
+    for (size_t code = 0; code < _liquidFrames.size(); code++)
+    {
+        auto& frames = _liquidFrames[code];
+        auto item    = config->getItemForCode(static_cast<uint16_t>(code));
+        frames       = {};
+
+        if (code == 0 || !item || item->getLayer() != BlockLayer::LIQUID)
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < frames.size(); i++)
+        {
+            frames[i] = cache->findFrame(std::format("{}-{}", item->getName(), i + 1));
+        }
+    }
 }
 
 void WorldRenderer::arrangeBlockSprites()
@@ -489,6 +519,10 @@ void WorldRenderer::arrangeBlockSprites()
     auto arrangeLR   = Point(lowerRight.x + 1.0F, lowerRight.y + 4.0F);
     auto arrangeRect = Rect(arrangeUL, arrangeLR - arrangeUL);
 
+    // Render blocks closest to the center of the screen first
+    auto center = (upperLeft + lowerRight) * 0.5F;
+    _renderQueue.setCenter((int16_t)center.x, (int16_t)center.y);
+
     // 0x10008058F: Do nothing if arrange rect has not changed since last update
     if (!_initialArrange && arrangeRect.equals(_lastArrangeRect))
     {
@@ -499,35 +533,25 @@ void WorldRenderer::arrangeBlockSprites()
     auto intersection = math_util::getRectIntersection(arrangeRect, _lastArrangeRect);
 
     // 0x100080668: Add new blocks to the render queue
-    for (auto x = arrangeRect.getMinX(); x <= arrangeRect.getMaxX(); x++)
+    for (auto block : BlockRectRange(_zone, arrangeRect))
     {
-        for (auto y = arrangeRect.getMinY(); y <= arrangeRect.getMaxY(); y++)
+        // Only add blocks that weren't already rendered last time
+        if ((_initialArrange || !intersection.containsPoint(Point(block->getX(), block->getY()))) &&
+            !block->isQueued())
         {
-            // Only add blocks that weren't already rendered last time
-            if (_initialArrange || !intersection.containsPoint({x, y}))
-            {
-                if (auto block = _zone->getBlockAt((int16_t)x, (int16_t)y))
-                {
-                    _renderQueue.pushBack(block);
-                }
-            }
+            block->setQueued(true);
+            _renderQueue.push(block);
         }
     }
 
     // 0x100080792: Clear blocks that are no longer visible
     if (!_initialArrange)
     {
-        for (auto x = _lastArrangeRect.getMinX(); x <= _lastArrangeRect.getMaxX(); x++)
+        for (auto block : BlockRectRange(_zone, _lastArrangeRect))
         {
-            for (auto y = _lastArrangeRect.getMinY(); y <= _lastArrangeRect.getMaxY(); y++)
+            if (!intersection.containsPoint(Point(block->getX(), block->getY())))
             {
-                if (!intersection.containsPoint({x, y}))
-                {
-                    if (auto block = _zone->getBlockAt((int16_t)x, (int16_t)y))
-                    {
-                        block->clearFromWorld();
-                    }
-                }
+                block->clearFromWorld();
             }
         }
     }
@@ -540,6 +564,8 @@ void WorldRenderer::arrangeBlockSprites()
 
 void WorldRenderer::renderBlockSprites()
 {
+    _blocksRenderedLastFrame = 0;
+
     if (_renderQueue.empty())
     {
         return;
@@ -555,187 +581,234 @@ void WorldRenderer::renderBlockSprites()
             break;
         }
 
-        auto block = _renderQueue[0];
+        auto block = _renderQueue.pop();
+        block->setQueued(false);
         block->setRendering(true);
         block->recycleSprites();
         block->postPlace();
+        placeBlockSprites(block);
+        block->bakeSprites();
+        block->setRendering(false);
+        _blocksRenderedLastFrame++;
+    }
+}
 
-        // 0x100080BDF: Determine front node
-        auto frontNode = _frontBlocksNode;
-        auto frontItem = block->getFrontItem();
+void WorldRenderer::placeBlockSprites(BaseBlock* block)
+{
+    // 0x100080BDF: Determine front node
+    auto frontNode = _frontBlocksNode;
+    auto frontItem = block->getFrontItem();
 
-        if (block->getFront() > 0)
+    if (block->getFront() > 0)
+    {
+        if (frontItem->isWhole())
+        {
+            frontNode = _fronterBlocksNode;
+        }
+        else if (auto frame = frontItem->getSpriteFrame())
         {
-            if (frontItem->isWhole())
+            if (frame->getTexture() == _fronterBlocksNode->getBatchNode()->getTexture() &&
+                frontItem->getSpriteZ() != -1)  // Exception for assembled fossils
             {
                 frontNode = _fronterBlocksNode;
             }
-            else if (auto frame = frontItem->getSpriteFrame())
-            {
-                if (frame->getTexture() == _fronterBlocksNode->getBatchNode()->getTexture() &&
-                    frontItem->getSpriteZ() != -1)  // Exception for assembled fossils
-                {
-                    frontNode = _fronterBlocksNode;
-                }
-            }
         }
+    }
 
-        // NOTE: Occlusion culling is handled by WorldLayerRenderer.
-        // Also, there shouldn't be a need to render liquid blocks here.
-        frontNode->placeBlock(block);
-        _backBlocksNode->placeBlock(block);
-        _baseBlocksNode->placeBlock(block);
-        block->setRendering(false);
-        _renderQueue.erase(0);
+    // NOTE: Occlusion culling is handled by WorldLayerRenderer.
+    // Also, there shouldn't be a need to render liquid blocks here.
+    frontNode->placeBlock(block);
+    _backBlocksNode->placeBlock(block);
+    _baseBlocksNode->placeBlock(block);
+}
+
+void WorldRenderer::unbakeBlock(BaseBlock* block)
+{
+    if (!block->hasBakedSprites())
+    {
+        return;
     }
+
+    // Sprites are baked again the next time the block is rendered
+    block->setRendering(true);
+    block->recycleSprites();
+    placeBlockSprites(block);
+    block->setRendering(false);
 }
 
 void WorldRenderer::processEffects()
 {
     // TODO: use captured screen blocks which is set by LightMapper for some mysterious reason
-    for (auto y = _blockRect.getMinY(); y < _blockRect.getMaxY(); y++)
+    BlockRectRange blocks(_zone, (int16_t)_blockRect.getMinX(), (int16_t)_blockRect.getMinY(),
+                          (int16_t)_blockRect.getMaxX() - 1, (int16_t)_blockRect.getMaxY() - 1);
+
+    if (blocks.isEmpty())
+    {
+        return;
+    }
+
+    // Only visit the blocks that chunks have indexed as having effects instead of every block on screen
+    auto chunkWidth  = _zone->getChunkWidth();
+    auto chunkHeight = _zone->getChunkHeight();
+
+    for (auto chunkY = blocks.getMinY() / chunkHeight; chunkY <= blocks.getMaxY() / chunkHeight; chunkY++)
     {
-        for (auto x = _blockRect.getMinX(); x < _blockRect.getMaxX(); x++)
+        for (auto chunkX = blocks.getMinX() / chunkWidth; chunkX <= blocks.getMaxX() / chunkWidth; chunkX++)
         {
-            auto block = _zone->getBlockAt((uint16_t)x, (uint16_t)y);
+            auto chunk = _zone->getChunkAt(chunkX, chunkY);
 
-            if (!block)
+            if (!chunk)
             {
                 continue;
             }
 
-            // 0x1000811EF: Emit block particles
-            auto frontItem = block->getFrontItem();
-            auto emitter   = frontItem->getEmitter();
-
-            if (!emitter)
+            for (auto slot : chunk->getEffectSlots())
             {
-                emitter = block->getLiquidItem()->getEmitter();
+                auto block = chunk->getBlockAtSlot(slot);
+                auto x     = block->getX();
+                auto y     = block->getY();
+
+                if (x >= blocks.getMinX() && x <= blocks.getMaxX() && y >= blocks.getMinY() && y <= blocks.getMaxY())
+                {
+                    processBlockEffects(block);
+                }
             }
+        }
+    }
+}
+
+void WorldRenderer::processBlockEffects(BaseBlock* block)
+{
+    // 0x1000811EF: Emit block particles
+    auto frontItem = block->getFrontItem();
+    auto emitter   = frontItem->getEmitter();
+
+    if (!emitter)
+    {
+        emitter = block->getLiquidItem()->getEmitter();
+    }
+
+    if (emitter)
+    {
+        emitParticle(emitter, block);
+    }
+
+    // Base, back, front
+    // NOTE: the original implementation is a lot less flexible and doesn't support all layers
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        auto layer                   = static_cast<BlockLayer>(i + 1);
+        WorldLayerRenderer* renderer = nullptr;
+        Item* item                   = nullptr;
+        uint8_t mod                  = 0;
 
-            if (emitter)
+        switch (layer)
+        {
+        case BlockLayer::BASE:
+            if (block->isBackOpaque() || block->isFrontOpaque())
             {
-                emitParticle(emitter, block);
+                continue;
             }
 
-            // Base, back, front
-            // NOTE: the original implementation is a lot less flexible and doesn't support all layers
-            for (uint8_t i = 0; i < 3; i++)
+            renderer = _baseBlocksNode;
+            item     = block->getBaseItem();
+            break;
+        case BlockLayer::BACK:
+            if (block->isFrontOpaque())
             {
-                auto layer                   = static_cast<BlockLayer>(i + 1);
-                WorldLayerRenderer* renderer = nullptr;
-                Item* item                   = nullptr;
-                uint8_t mod                  = 0;
+                continue;
+            }
 
-                switch (layer)
-                {
-                case BlockLayer::BASE:
-                    if (block->isBackOpaque() || block->isFrontOpaque())
-                    {
-                        continue;
-                    }
+            renderer = _backBlocksNode;
+            item     = block->getBackItem();
+            mod      = block->getBackMod();
+            break;
+        case BlockLayer::FRONT:
+            renderer = _frontBlocksNode;
+            item     = frontItem;
+            mod      = block->getFrontMod();
+            break;
+        }
 
-                    renderer = _baseBlocksNode;
-                    item     = block->getBaseItem();
-                    break;
-                case BlockLayer::BACK:
-                    if (block->isFrontOpaque())
-                    {
-                        continue;
-                    }
+        // Cycle sprite animation
+        auto& spriteAnimation = item->getSpriteAnimation();
 
-                    renderer = _backBlocksNode;
-                    item     = block->getBackItem();
-                    mod      = block->getBackMod();
-                    break;
-                case BlockLayer::FRONT:
-                    renderer = _frontBlocksNode;
-                    item     = frontItem;
-                    mod      = block->getFrontMod();
-                    break;
-                }
+        if (!spriteAnimation.empty())
+        {
+            auto tag = WorldLayerRenderer::ANIMATED_SPRITE_TAG - i;
+            block->recycleSpriteWithTag(tag);
+            auto frame  = spriteAnimation[_fxFrame % spriteAnimation.size()];
+            auto sprite = renderer->placeSprite(block, nullptr, frame, false, true, item->getModType(), mod, 2);
+            sprite->setColor(item->getSpriteAnimationColor());
+            sprite->setTag(tag);
+        }
 
-                // Cycle sprite animation
-                auto& spriteAnimation = item->getSpriteAnimation();
+        // Apply glow effect
+        if (item->getGlow() > 0.0F)
+        {
+            auto sprite = block->getTopSpriteForLayer(layer);
+            sprite->setOpacity(random(0xF0, 0xFF));
+        }
 
-                if (!spriteAnimation.empty())
-                {
-                    auto tag = WorldLayerRenderer::ANIMATED_SPRITE_TAG - i;
-                    block->recycleSpriteWithTag(tag);
-                    auto frame  = spriteAnimation[_fxFrame % spriteAnimation.size()];
-                    auto sprite = renderer->placeSprite(block, nullptr, frame, false, true, item->getModType(), mod, 2);
-                    sprite->setColor(item->getSpriteAnimationColor());
-                    sprite->setTag(tag);
-                }
+        // Cycle continuity animation
+        auto& continuityAnimation = item->getSpriteContinuityAnimation();
 
-                // Apply glow effect
-                if (item->getGlow() > 0.0F)
-                {
-                    auto sprite = block->getTopSpriteForLayer(layer);
-                    sprite->setOpacity(random(0xF0, 0xFF));
-                }
-
-                // Cycle continuity animation
-                auto& continuityAnimation = item->getSpriteContinuityAnimation();
+        if (!continuityAnimation.empty())
+        {
+            auto tag         = WorldLayerRenderer::ANIMATED_SPRITE_TAG - 3 - i;
+            auto continuity  = block->getContinuityForLayer(layer);
+            auto& spriteInfo = continuityAnimation[continuity & 0xF].back();
+            auto& options    = spriteInfo.options;
+            auto frame       = options[_fxFrame % options.size()];
+            auto rotation    = spriteInfo.rotation;
+            block->recycleSpriteWithTag(tag);
+            auto sprite =
+                renderer->placeSprite(block, nullptr, frame, true, true, ModType::ROTATION_DEGREES, rotation,
+                                      item->getSpriteZ() + 1);  // HACK: always render on top
+            sprite->setOpacity(item->getSpriteContinuityAnimationOpacity());
+            sprite->setTag(tag);
+        }
+    }
 
-                if (!continuityAnimation.empty())
+    // 0x100081582: Special emitters
+    if (frontItem->getSpecialPlacement() != SpecialPlacement::NONE)
+    {
+        switch (frontItem->getCode())
+        {
+        // Purifier
+        case item_codes::GECK_TUB:
+        {
+            if (block->getFrontMod() > 0)
+            {
+                if (auto emitter = GameConfig::getMain()->getEmitterForName("sparkle up"))
                 {
-                    auto tag         = WorldLayerRenderer::ANIMATED_SPRITE_TAG - 3 - i;
-                    auto continuity  = block->getContinuityForLayer(layer);
-                    auto& spriteInfo = continuityAnimation[continuity & 0xF].back();
-                    auto& options    = spriteInfo.options;
-                    auto frame       = options[_fxFrame % options.size()];
-                    auto rotation    = spriteInfo.rotation;
-                    block->recycleSpriteWithTag(tag);
-                    auto sprite =
-                        renderer->placeSprite(block, nullptr, frame, true, true, ModType::ROTATION_DEGREES, rotation,
-                                              item->getSpriteZ() + 1);  // HACK: always render on top
-                    sprite->setOpacity(item->getSpriteContinuityAnimationOpacity());
-                    sprite->setTag(tag);
+                    auto position = block->getWorldPosition();
+                    emitParticle(emitter, position + Vec2(BLOCK_SIZE * 0.5F, BLOCK_SIZE * 2.0F));
+                    emitParticle(emitter, position + Vec2(BLOCK_SIZE * 1.5F, BLOCK_SIZE * 2.0F));
                 }
             }
-
-            // 0x100081582: Special emitters
-            if (frontItem->getSpecialPlacement() != SpecialPlacement::NONE)
+            break;
+        }
+        // Composter
+        case item_codes::COMPOSTER_CHAMBER:
+        {
+            if (block->getFrontMod() > 0)
             {
-                switch (frontItem->getCode())
-                {
-                // Purifier
-                case item_codes::GECK_TUB:
-                {
-                    if (block->getFrontMod() > 0)
-                    {
-                        if (auto emitter = GameConfig::getMain()->getEmitterForName("sparkle up"))
-                        {
-                            auto position = block->getWorldPosition();
-                            emitParticle(emitter, position + Vec2(BLOCK_SIZE * 0.5F, BLOCK_SIZE * 2.0F));
-                            emitParticle(emitter, position + Vec2(BLOCK_SIZE * 1.5F, BLOCK_SIZE * 2.0F));
-                        }
-                    }
-                    break;
-                }
-                // Composter
-                case item_codes::COMPOSTER_CHAMBER:
+                if (auto emitter = GameConfig::getMain()->getEmitterForName("shadow steam"))
                 {
-                    if (block->getFrontMod() > 0)
-                    {
-                        if (auto emitter = GameConfig::getMain()->getEmitterForName("shadow steam"))
-                        {
-                            auto position = block->getWorldPosition();
-                            position.y += BLOCK_SIZE * 2.5F;
+                    auto position = block->getWorldPosition();
+                    position.y += BLOCK_SIZE * 2.5F;
 
-                            if (auto particle = emitParticle(emitter, position))
-                            {
-                                particle->getPhysical()->setVelocity(Vec2::UNIT_Y * BLOCK_SIZE);
-                            }
-                        }
+                    if (auto particle = emitParticle(emitter, position))
+                    {
+                        particle->getPhysical()->setVelocity(Vec2::UNIT_Y * BLOCK_SIZE);
                     }
-                    break;
-                }
-                default:
-                    break;
                 }
             }
+            break;
+        }
+        default:
+            break;
         }
     }
 }
@@ -810,6 +883,7 @@ WorldLayerRenderer* WorldRenderer::createLayerRenderer(const std::string& name,
     auto renderer    = WorldLayerRenderer::createWithLayer(layer, batchNode);
     renderer->setName(name);
     renderer->setBiomeRenderer(biomeRenderer);
+    renderer->setMeshEnabled(!biomeRenderer && layer != BlockLayer::LIQUID);  // Biome textures can be swapped out
     _foreground->addChild(renderer, z == -1 ? getNextZIndex() : z);
     return renderer;
 }
@@ -831,24 +905,23 @@ bool WorldRenderer::isBlockInViewport(BaseBlock* block) const
 
 void WorldRenderer::queueBlockForRendering(BaseBlock* block)
 {
+    // Blocks that are already queued keep their original queue time, same as the first of multiple entries would
+    if (block->isQueued())
+    {
+        return;
+    }
+
+    block->setQueued(true);
     block->setQueuedAt(utils::gettime());
-    _renderQueue.pushBack(block);
+    _renderQueue.push(block);
 }
 
 bool WorldRenderer::hasRenderedAllPlacedBlocks() const
 {
-    if (!_renderQueue.empty())
-    {
-        for (auto block : _renderQueue)
-        {
-            if (block->getQueuedAt() < _zone->getDoneWaitingForBlocksAt())
-            {
-                return false;
-            }
-        }
-    }
-
-    return true;
+    auto doneWaitingAt = _zone->getDoneWaitingForBlocksAt();
+    auto renderedAll   = true;
+    _renderQueue.forEach([&](BaseBlock* block) { renderedAll &= block->getQueuedAt() >= doneWaitingAt; });
+    return renderedAll;
 }
 
 Entity* WorldRenderer::addEntity(int32_t code, const std::string& name, const ValueMap& details)
@@ -1119,11 +1192,13 @@ void WorldRenderer::generateMiningDebris(BaseBlock* block, BlockLayer layer, boo
 
 void WorldRenderer::generateBlockDebris(BaseBlock* block, BlockLayer layer, bool ineffectual, ssize_t count)
 {
-    if (_freeDebrisIndex >= DEBRIS_POOL_SIZE)
+    if (ineffectual && _freeDebrisIndex >= DEBRIS_POOL_SIZE)
     {
         return;  // Debris pool empty, skip
     }
 
+    unbakeBlock(block);
+
     if (auto sprite = block->getMainSpriteForLayer(layer))
     {
         // This check serves as a replacement for the layerRendererForItem function
@@ -1152,31 +1227,34 @@ void WorldRenderer::generateBlockDebris(BaseBlock* block, BlockLayer layer, bool
         // Spawn particles
         for (ssize_t i = 0; i < count; i++)
         {
-            if (_freeDebrisIndex >= DEBRIS_POOL_SIZE)
+            auto angle = MATH_DEG_TO_RAD(random(0.0F, 360.0F));
+
+            // Block debris is simulated without Chipmunk in the debris system of the renderer
+            if (!ineffectual)
             {
-                break;  // Debris pool empty, stop
-            }
+                if (!renderer->getDebrisSystem()->spawnForSprite(sprite, position, velocity, angle))
+                {
+                    break;  // Debris budget used up, stop
+                }
 
-            auto debris = _debrisPool[_freeDebrisIndex++];
-            auto angle  = MATH_DEG_TO_RAD(random(0.0F, 360.0F));
+                continue;
+            }
 
-            if (!ineffectual)
+            if (_freeDebrisIndex >= DEBRIS_POOL_SIZE)
             {
-                debris->spawnForSprite(sprite, position, velocity);
-                debris->getPhysical()->getBody()->setAngle(angle);
+                break;  // Debris pool empty, stop
             }
-            else
+
+            if (auto emitter = GameConfig::getMain()->getEmitterForName("steam"))
             {
-                if (auto emitter = GameConfig::getMain()->getEmitterForName("steam"))
-                {
-                    debris->spawnParticle(emitter, position);
-                    auto body = debris->getPhysical()->getBody();
-                    body->setVelocity(velocity * 0.5F);
-                    body->setAngle(angle);
-                    debris->setColor(color_util::rgbToColor(0x5A3C1E));
-                    debris->setScale(debris->getScale() * 0.5F);
-                    _nextDebrisAt += 0.05F;
-                }
+                auto debris = _debrisPool[_freeDebrisIndex++];
+                debris->spawnParticle(emitter, position);
+                auto body = debris->getPhysical()->getBody();
+                body->setVelocity(velocity * 0.5F);
+                body->setAngle(angle);
+                debris->setColor(color_util::rgbToColor(0x5A3C1E));
+                debris->setScale(debris->getScale() * 0.5F);
+                _nextDebrisAt += 0.05F;
             }
         }
     }
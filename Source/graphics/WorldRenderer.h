@@ -3,6 +3,8 @@
 
 #include "axmol.h"
 
+#include "graphics/BlockRenderQueue.h"
+
 namespace opendw
 {
 
@@ -55,15 +57,27 @@ public:
     /* FUNC: WorldRenderer::loadBiome: @ 0x100080126 */
     void loadBiome(const std::string& biome);
 
+    /* Looks up the animation frames of every liquid so that cycling them doesn't need to. */
+    void loadLiquidFrames();
+
     /* FUNC: WorldRenderer::arrangeBlockSprites @ 0x100080495 */
     void arrangeBlockSprites();
 
     /* FUNC: WorldRenderer::renderBlockSprites @ 0x1000808D3 */
     void renderBlockSprites();
 
+    /* Places the sprites of a block in all layers except liquid. */
+    void placeBlockSprites(BaseBlock* block);
+
+    /* Replaces the baked quads of a block with live sprites so that they can be animated or inspected. */
+    void unbakeBlock(BaseBlock* block);
+
     /* FUNC: WorldRenderer::processEffects @ 0x100080E11 */
     void processEffects();
 
+    /* Emits particles and updates animated, glowing and special sprites of a single block. */
+    void processBlockEffects(BaseBlock* block);
+
     /* FUNC: WorldRenderer::updateLiquidInBlock: @ 0x100082164 */
     void updateLiquidInBlock(BaseBlock* block);
 
@@ -92,6 +106,12 @@ public:
     /* FUNC: WorldRenderer::hasRenderedAllPlacedBlocks @ 0x100081DAD */
     bool hasRenderedAllPlacedBlocks() const;
 
+    /* @return The number of blocks currently waiting to be rendered. */
+    size_t getRenderQueueSize() const { return _renderQueue.size(); }
+
+    /* @return The number of blocks that were taken off the render queue during the last update. */
+    size_t getBlocksRenderedLastFrame() const { return _blocksRenderedLastFrame; }
+
     /* FUNC: WorldRenderer::addEntity:name:details: @ 0x1000825E0 */
     Entity* addEntity(int32_t code, const std::string& name, const ax::ValueMap& details);
 
@@ -135,6 +155,9 @@ public:
     /* FUNC: WorldRenderer::worldScale @ 0x100086DD9 */
     float getWorldScale() const { return _worldScale; }
 
+    /* @return The area of the world that is on screen, in node space. */
+    const ax::Rect& getVisibleRect() const { return _visibleRect; }
+
     /* FUNC: WorldRenderer::nodePointForScreenPoint: @ 0x1000830CB */
     ax::Point getNodePointForScreenPoint(const ax::Point& point) const;
 
@@ -178,6 +201,8 @@ public:
     Lightmapper* getLightmapper() const { return _lightmapper; }
 
 private:
+    static constexpr auto LIQUID_FRAME_COUNT = 3;
+
     inline static WorldRenderer* sMain;  // 0x10032EAF8
 
     WorldZone* _zone;                             // WorldRenderer::zone @ 0x100311DE8
@@ -210,7 +235,7 @@ private:
     ax::Node* _glowNode;                          // WorldRenderer::glowNode @ 0x100311F08
     ax::Node* _vectorLayer;                       // WorldRenderer::vectorLayer @ 0x100311F10
     ax::Node* _physicsDebugNode;                  // WorldRenderer::physicsDebugNode @ 0x100311F20
-    ax::Vector<BaseBlock*> _renderQueue;          // WorldRenderer::renderQueue @ 0x100311DF8
+    BlockRenderQueue _renderQueue;                // WorldRenderer::renderQueue @ 0x100311DF8
     ax::Rect _visibleRect;                        // WorldRenderer::visibleRect @ 0x100311FA0
     ax::Rect _lastArrangeRect;                    // WorldRenderer::lastArrangeRect @ 0x100311FF8
     ax::Rect _blockRect;                          // WorldRenderer::blockRect @ 0x100312008
@@ -228,8 +253,10 @@ private:
     float _explosion;                             // WorldRenderer::explosion @ 0x100311FB8
     size_t _liquidFrame;                          // 0x100320BC0
     bool _initialArrange;
+    size_t _blocksRenderedLastFrame;
     ssize_t _freeDebrisIndex;
     ax::Point _cameraPosition;
+    std::array<std::array<ax::SpriteFrame*, LIQUID_FRAME_COUNT>, 256> _liquidFrames;  // Indexed by liquid code
 };
 
 }  // namespace opendw
@@ -29,43 +29,61 @@ void MaskedQuadBatch::setQuad(ssize_t index, const Quad& quad)
     AXASSERT(index >= 0 && index < _capacity, "Index is out of bounds");
     _totalQuads = MAX(_totalQuads, index + 1);
     _quads[index] = quad;
-    _dirty        = true;
+    markDirty(index, index + 1);
 }
 
-void MaskedQuadBatch::insertQuad(ssize_t index, const Quad& quad)
+void MaskedQuadBatch::clearQuad(ssize_t index)
 {
-    AXASSERT(index >= 0 && index < _capacity, "Index is out of bounds");
-    AXASSERT(_totalQuads < _capacity, "Capacity has been reached");
-    auto quadsToMove = _totalQuads - index;
+    AXASSERT(index >= 0 && index < _totalQuads, "Index is out of bounds");
+    memset(&_quads[index], 0, sizeof(Quad));
+    markDirty(index, index + 1);
+}
+
+void MaskedQuadBatch::truncate(ssize_t totalQuads)
+{
+    AXASSERT(totalQuads >= 0 && totalQuads <= _totalQuads, "Count is out of bounds");
+
+    if (totalQuads != _totalQuads)
+    {
+        _totalQuads = totalQuads;
+        _dirty      = true;  // Only the draw count changes
+    }
+}
 
-    if (quadsToMove)
+void MaskedQuadBatch::markDirty(ssize_t begin, ssize_t end)
+{
+    if (_dirtyBegin >= _dirtyEnd)
+    {
+        _dirtyBegin = begin;
+        _dirtyEnd   = end;
+    }
+    else
     {
-        memmove(&_quads[index + 1], &_quads[index], sizeof(Quad) * quadsToMove);
+        _dirtyBegin = MIN(_dirtyBegin, begin);
+        _dirtyEnd   = MAX(_dirtyEnd, end);
     }
 
-    _totalQuads++;
     _dirty = true;
 }
 
-void MaskedQuadBatch::removeQuad(ssize_t index)
+void MaskedQuadBatch::setDirty(bool dirty)
 {
-    AXASSERT(index >= 0 && index < _totalQuads, "Index is out of bounds");
-    auto quadsToMove = _totalQuads - index - 1;
-
-    if (quadsToMove)
+    if (dirty)
     {
-        memmove(&_quads[index], &_quads[index + 1], sizeof(Quad) * quadsToMove);
+        markDirty(0, _capacity);
+        return;
     }
 
-    _totalQuads--;
-    _dirty = true;
+    _dirtyBegin = 0;
+    _dirtyEnd   = 0;
+    _dirty      = false;
 }
 
 void MaskedQuadBatch::clear()
 {
     memset(_quads, 0, _capacity * sizeof(Quad));
     _totalQuads = 0;
-    _dirty      = true;
+    setDirty(true);
 }
 
 bool MaskedQuadBatch::setCapacity(ssize_t capacity)
@@ -112,7 +130,7 @@ bool MaskedQuadBatch::setCapacity(ssize_t capacity)
     _quads      = quads;
     _capacity   = capacity;
     _totalQuads = MIN(_totalQuads, _capacity);
-    _dirty      = true;
+    setDirty(true);
     return true;
 }
 
@@ -20,8 +20,12 @@ public:
     bool initWithCapacity(ssize_t capacity);
 
     void setQuad(ssize_t index, const Quad& quad);
-    void insertQuad(ssize_t index, const Quad& quad);
-    void removeQuad(ssize_t index);
+
+    /* Zeroes the quad at the specified index so that it draws nothing. */
+    void clearQuad(ssize_t index);
+
+    /* Drops all quads past the specified count. */
+    void truncate(ssize_t totalQuads);
 
     void clear();
 
@@ -31,12 +35,24 @@ public:
 
     Quad* getQuads() const { return _quads; }
 
-    void setDirty(bool dirty) { _dirty = dirty; }
+    /* Marks the quads in [begin, end) as changed. */
+    void markDirty(ssize_t begin, ssize_t end);
+
+    /* Marking as dirty flags every quad, marking as clean resets the dirty range. */
+    void setDirty(bool dirty);
     bool isDirty() const { return _dirty; }
 
+    /* @return The start of the range of quads that changed since the batch was last marked as clean. */
+    ssize_t getDirtyBegin() const { return _dirtyBegin; }
+
+    /* @return The end (exclusive) of the range of quads that changed since the batch was last marked as clean. */
+    ssize_t getDirtyEnd() const { return MIN(_dirtyEnd, _totalQuads); }
+
 private:
     ssize_t _capacity;
     ssize_t _totalQuads;
+    ssize_t _dirtyBegin;
+    ssize_t _dirtyEnd;
     Quad* _quads;
     bool _dirty;
 };
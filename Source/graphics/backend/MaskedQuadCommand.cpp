@@ -1,6 +1,7 @@
 #include "MaskedQuadCommand.h"
 
 #define MAX_INDEX_CAPACITY 0x20000
+#define BUFFER_GROWTH      1.25F  // Headroom given to buffers when they need to grow
 
 USING_NS_AX;
 
@@ -34,12 +35,43 @@ void MaskedQuadCommand::init(float globalZOrder,
     if (quadCount * 6 > _indexCount)
     {
         reindex(quadCount * 6);
+        _indexCount = sIndexCapacity;  // Shared indices only ever grow, so skip reindexing until we outgrow them
     }
 
     Triangles triangles(&quads->tl, sIndices, quadCount * 4, quadCount * 6);
     MaskedTrianglesCommand::init(globalZOrder, texture, maskTexture, blendFunc, triangles, modelView, flags);
 }
 
+void MaskedQuadCommand::populateBuffers(int firstQuad, int quadCount)
+{
+    auto vertexCount = _triangles.vertexCount;
+    auto indexCount  = _triangles.indexCount;
+
+    if (vertexCount > _vertexCapacity)
+    {
+        auto capacity = static_cast<int>(vertexCount / 4 * BUFFER_GROWTH) * 4;
+        createVertexBuffer(sizeof(Vertex), capacity, BufferUsage::DYNAMIC);
+        firstQuad = 0;
+        quadCount = vertexCount / 4;
+    }
+
+    if (indexCount > _indexCapacity)
+    {
+        // Indices never change, so upload them once per buffer with the same headroom as the vertices
+        auto capacity = MIN(static_cast<int>(indexCount / 6 * BUFFER_GROWTH), sIndexCapacity / 6) * 6;
+        createIndexBuffer(IndexFormat::U_SHORT, capacity, BufferUsage::DYNAMIC);
+        updateIndexBuffer(sIndices, sizeof(uint16_t) * capacity);
+    }
+
+    setIndexDrawInfo(0, indexCount);
+
+    if (quadCount > 0)
+    {
+        auto vertexSize = sizeof(Vertex) * 4;
+        updateVertexBuffer(_triangles.vertices + firstQuad * 4, firstQuad * vertexSize, quadCount * vertexSize);
+    }
+}
+
 void MaskedQuadCommand::reindex(int indexCount)
 {
     if (sIndexCapacity == -1)
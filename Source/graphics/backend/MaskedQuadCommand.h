@@ -31,6 +31,13 @@ public:
 
     void reindex(int indexCount);
 
+    /*
+     * Uploads a range of quads to the vertex buffer.
+     * Buffers grow with some headroom and are only reallocated when they run out of space, at which point everything is
+     * uploaded. Quad indices never change, so the index buffer is only uploaded when it is reallocated.
+     */
+    void populateBuffers(int firstQuad, int quadCount);
+
 private:
     inline static int sIndexCapacity = -1;
     inline static uint16_t* sIndices;
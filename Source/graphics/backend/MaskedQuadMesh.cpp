@@ -0,0 +1,139 @@
+#include "MaskedQuadMesh.h"
+
+#include "graphics/backend/MaskedSpriteBatchNode.h"
+#include "CommonDefs.h"
+
+USING_NS_AX;
+
+namespace opendw
+{
+
+MaskedQuadMesh* MaskedQuadMesh::createWithBatchNode(MaskedSpriteBatchNode* batchNode)
+{
+    CREATE_INIT(MaskedQuadMesh, initWithBatchNode, batchNode);
+}
+
+bool MaskedQuadMesh::initWithBatchNode(MaskedSpriteBatchNode* batchNode)
+{
+    AXASSERT(batchNode, "Batch node can't be nullptr");
+
+    if (!Node::init())
+    {
+        return false;
+    }
+
+    _batchNode = batchNode;
+    return true;
+}
+
+void MaskedQuadMesh::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+    if (_dirty)
+    {
+        rebuild();
+    }
+
+    if (_quads.empty())
+    {
+        return;
+    }
+
+    // Skip meshes that are entirely off screen
+    auto boundsTransform = transform;
+    boundsTransform.translate(_bounds.origin.x, _bounds.origin.y, 0.0F);
+
+    if (!renderer->checkVisibility(boundsTransform, _bounds.size))
+    {
+        return;
+    }
+
+    _quadCommand.init(_globalZOrder, _batchNode->getTexture(), _batchNode->getMaskTexture(),
+                      _batchNode->getBlendFunc(), _quads.data(), static_cast<int>(_quads.size()), transform, flags);
+
+    if (_buffersDirty)
+    {
+        _quadCommand.populateBuffers(0, static_cast<int>(_quads.size()));
+        _buffersDirty = false;
+    }
+
+    renderer->addCommand(&_quadCommand);
+}
+
+void MaskedQuadMesh::addQuad(uint32_t slot, const Quad& quad, int z)
+{
+    if (slot >= _slots.size())
+    {
+        _slots.resize(slot + 1);
+    }
+
+    _slots[slot].push_back({quad, z, _nextOrder++});
+    _quadCount++;
+    _dirty = true;
+}
+
+void MaskedQuadMesh::removeQuads(uint32_t slot)
+{
+    if (slot >= _slots.size() || _slots[slot].empty())
+    {
+        return;
+    }
+
+    _quadCount -= _slots[slot].size();
+    _slots[slot].clear();
+    _dirty = true;
+}
+
+void MaskedQuadMesh::clear()
+{
+    for (auto& entries : _slots)
+    {
+        entries.clear();
+    }
+
+    _quadCount = 0;
+    _nextOrder = 0;
+    _dirty     = true;
+}
+
+void MaskedQuadMesh::rebuild()
+{
+    _sortBuffer.clear();
+    _sortBuffer.reserve(_quadCount);
+
+    for (auto& entries : _slots)
+    {
+        for (auto& entry : entries)
+        {
+            _sortBuffer.push_back(&entry);
+        }
+    }
+
+    std::sort(_sortBuffer.begin(), _sortBuffer.end(), [](const Entry* a, const Entry* b) {
+        return a->z != b->z ? a->z < b->z : a->order < b->order;
+    });
+
+    _quads.clear();
+    _quads.reserve(_quadCount);
+    Vec2 min(FLT_MAX, FLT_MAX);
+    Vec2 max(-FLT_MAX, -FLT_MAX);
+
+    for (auto entry : _sortBuffer)
+    {
+        auto& quad = entry->quad;
+        _quads.push_back(quad);
+
+        for (auto vertex : {&quad.tl, &quad.bl, &quad.tr, &quad.br})
+        {
+            min.x = MIN(min.x, vertex->position.x);
+            min.y = MIN(min.y, vertex->position.y);
+            max.x = MAX(max.x, vertex->position.x);
+            max.y = MAX(max.y, vertex->position.y);
+        }
+    }
+
+    _bounds       = _quads.empty() ? Rect::ZERO : Rect(min, max - min);
+    _dirty        = false;
+    _buffersDirty = true;
+}
+
+}  // namespace opendw
@@ -0,0 +1,63 @@
+#ifndef __MASKED_QUAD_MESH_H__
+#define __MASKED_QUAD_MESH_H__
+
+#include "axmol.h"
+
+#include "graphics/backend/MaskedQuadCommand.h"
+
+namespace opendw
+{
+
+class MaskedSpriteBatchNode;
+
+/*
+ * Static mesh of pre-transformed masked quads that shares the textures of a batch node.
+ * Quads are grouped into numbered slots so that everything belonging to one owner can be replaced at once. The vertex
+ * data is only rebuilt and uploaded when a slot has changed, so drawing an unchanged mesh costs a single command.
+ */
+class MaskedQuadMesh : public ax::Node
+{
+public:
+    typedef MaskedQuadCommand::Quad Quad;
+
+    static MaskedQuadMesh* createWithBatchNode(MaskedSpriteBatchNode* batchNode);
+
+    bool initWithBatchNode(MaskedSpriteBatchNode* batchNode);
+
+    void draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags) override;
+
+    /* Adds a quad to a slot. Quads are drawn in ascending z order, and in the order they were added otherwise. */
+    void addQuad(uint32_t slot, const Quad& quad, int z);
+
+    /* Removes all quads in a slot. */
+    void removeQuads(uint32_t slot);
+
+    void clear();
+
+    size_t getQuadCount() const { return _quadCount; }
+
+private:
+    struct Entry
+    {
+        Quad quad;
+        int z;
+        uint32_t order;
+    };
+
+    void rebuild();
+
+    MaskedSpriteBatchNode* _batchNode;  // Provides the textures and blend function
+    MaskedQuadCommand _quadCommand;
+    std::vector<std::vector<Entry>> _slots;
+    std::vector<const Entry*> _sortBuffer;
+    std::vector<Quad> _quads;
+    ax::Rect _bounds;
+    size_t _quadCount   = 0;
+    uint32_t _nextOrder = 0;
+    bool _dirty         = false;  // Quad array is out of date
+    bool _buffersDirty  = false;  // Command buffers are out of date
+};
+
+}  // namespace opendw
+
+#endif  // __MASKED_QUAD_MESH_H__
@@ -62,7 +62,7 @@ void MaskedSprite::draw(Renderer* renderer, const Mat4& transform, uint32_t flag
 
 
     _maskedQuadCommand.init(_globalZOrder, _texture, _maskTexture, _blendFunc, &_maskedQuad, 1, transform, flags);
-    _maskedQuadCommand.populateBuffers();
+    _maskedQuadCommand.populateBuffers(0, 1);
     renderer->addCommand(&_maskedQuadCommand);
 }
 
@@ -157,6 +157,16 @@ void MaskedSprite::updateTransform()
     Node::updateTransform();
 }
 
+void MaskedSprite::setDirty(bool dirty)
+{
+    Sprite::setDirty(dirty);
+
+    if (dirty && _maskedBatchNode)
+    {
+        _maskedBatchNode->queueSpriteUpdate(this);
+    }
+}
+
 void MaskedSprite::updateMaskCoords()
 {
     if (_renderMode == RenderMode::QUAD_BATCHNODE && !_maskedBatchNode)
@@ -231,6 +241,11 @@ void MaskedSprite::setMaskRect(const Rect& rect)
     {
         _maskRect  = rect;
         _maskDirty = true;
+
+        if (_maskedBatchNode)
+        {
+            _maskedBatchNode->queueSpriteUpdate(this);
+        }
     }
 }
 
@@ -240,6 +255,11 @@ void MaskedSprite::setMaskOrientation(MaskOrientation orientation)
     {
         _maskOrientation = orientation;
         _maskDirty       = true;
+
+        if (_maskedBatchNode)
+        {
+            _maskedBatchNode->queueSpriteUpdate(this);
+        }
     }
 }
 
@@ -29,6 +29,9 @@ public:
 
     virtual void updateTransform() override;
 
+    /* Also queues the sprite for an update in its batch node, which only updates sprites that changed. */
+    virtual void setDirty(bool dirty) override;
+
     void updateMaskCoords();
     void copyQuadToMaskedQuad();
 
@@ -50,6 +53,8 @@ public:
     ssize_t getMaskedBatchIndex() const { return _maskedBatchIndex; }
     
 protected:
+    friend class MaskedSpriteBatchNode;
+
     virtual void updateColor() override;
     virtual void setTextureCoords(const ax::Rect& rect, ax::V3F_C4B_T2F_Quad* outQuad) override;
 
@@ -61,6 +66,7 @@ protected:
     MaskedSpriteBatchNode* _maskedBatchNode;
     ssize_t _maskedBatchIndex;
     bool _maskDirty;
+    bool _updateQueued = false;  // Waiting to be updated by the batch node
 };
 
 }  // namespace opendw
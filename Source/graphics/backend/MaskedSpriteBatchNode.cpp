@@ -5,6 +5,7 @@
 #include "CommonDefs.h"
 
 #define DEFAULT_CAPACITY 600
+#define COMPACT_RATIO    2  // Compact quads once more than 1 / n of the slots are free
 
 USING_NS_AX;
 
@@ -46,7 +47,8 @@ bool MaskedSpriteBatchNode::initWithTexture(Texture2D* texture, Texture2D* maskT
     _texture     = texture;
     _maskTexture = maskTexture;
     _blendFunc = texture->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED : BlendFunc::ALPHA_NON_PREMULTIPLIED;
-    _quadBatch = MaskedQuadBatch::createWithCapacity(capacity);
+    _quadBatch  = MaskedQuadBatch::createWithCapacity(capacity);
+    _orderDirty = false;
     AX_SAFE_RETAIN(_quadBatch);
     _children.reserve(capacity);
     _descendants.reserve(capacity);
@@ -74,6 +76,15 @@ void MaskedSpriteBatchNode::visit(Renderer* renderer, const Mat4& parentTransfor
 
 void MaskedSpriteBatchNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
+    // Only sprites that changed since the last draw need their quads recomputed
+    for (size_t i = 0; i < _pendingUpdates.size(); i++)
+    {
+        auto sprite           = _pendingUpdates[i];
+        sprite->_updateQueued = false;
+        sprite->updateTransform();
+    }
+
+    _pendingUpdates.clear();
     auto totalQuads = _quadBatch->getTotalQuads();
     auto quads      = _quadBatch->getQuads();
 
@@ -82,17 +93,14 @@ void MaskedSpriteBatchNode::draw(Renderer* renderer, const Mat4& transform, uint
         return;
     }
 
-    for (const auto& child : _children)
-    {
-        child->updateTransform();
-    }
-
     _quadCommand.init(_globalZOrder, _texture, _maskTexture, _blendFunc, quads, totalQuads, transform, flags);
 
-    // Only update command buffers if quad batch is dirty
+    // Only upload the quads that changed since the last draw
     if (_quadBatch->isDirty())
     {
-        _quadCommand.populateBuffers();
+        auto begin = _quadBatch->getDirtyBegin();
+        auto end   = _quadBatch->getDirtyEnd();
+        _quadCommand.populateBuffers(static_cast<int>(begin), static_cast<int>(MAX(0, end - begin)));
         _quadBatch->setDirty(false);
     }
 
@@ -129,14 +137,31 @@ void MaskedSpriteBatchNode::removeChild(Node* child, bool cleanup)
 
 void MaskedSpriteBatchNode::removeAllChildrenWithCleanup(bool cleanup)
 {
+    for (auto& sprite : _pendingUpdates)
+    {
+        sprite->_updateQueued = false;
+    }
+
     for (auto& sprite : _descendants)
     {
-        sprite->setMaskedBatchNode(nullptr);
+        if (sprite)
+        {
+            sprite->setMaskedBatchNode(nullptr);
+        }
     }
 
     Node::removeAllChildrenWithCleanup(cleanup);
     _descendants.clear();
+    _freeSlots.clear();
+    _pendingUpdates.clear();
     _quadBatch->clear();
+    _orderDirty = false;
+}
+
+void MaskedSpriteBatchNode::reorderChild(Node* child, int zOrder)
+{
+    Node::reorderChild(child, zOrder);
+    _orderDirty = true;
 }
 
 void MaskedSpriteBatchNode::updateSprite(MaskedSprite* sprite)
@@ -144,23 +169,71 @@ void MaskedSpriteBatchNode::updateSprite(MaskedSprite* sprite)
     _quadBatch->setQuad(sprite->getMaskedBatchIndex(), sprite->getMaskedQuad());
 }
 
+void MaskedSpriteBatchNode::queueSpriteUpdate(MaskedSprite* sprite)
+{
+    // Nested sprites are transformed relative to their parent, so always update from the top-level sprite down
+    Node* root = sprite;
+
+    while (root->getParent() && root->getParent() != this)
+    {
+        root = root->getParent();
+    }
+
+    if (root->getParent() != this)
+    {
+        return;  // Not attached to the batch (yet)
+    }
+
+    auto topSprite = static_cast<MaskedSprite*>(root);
+
+    if (!topSprite->_updateQueued)
+    {
+        topSprite->_updateQueued = true;
+        _pendingUpdates.push_back(topSprite);
+    }
+}
+
 void MaskedSpriteBatchNode::insertSprite(MaskedSprite* sprite)
 {
     _reorderChildDirty = true;
     sprite->setMaskedBatchNode(this);
     sprite->setDirty(true);
-    auto capacity = _quadBatch->getCapacity();
+    ssize_t index = 0;
 
-    if (_quadBatch->getTotalQuads() == capacity)
+    // Appending only keeps the quads in order if the sprite is a direct child that sorts after all others
+    auto childCount = _children.size();
+    auto inOrder    = sprite->getParent() == this && sprite->getChildren().empty() &&
+                   (childCount < 2 || _children.at(childCount - 2)->getLocalZOrder() <= sprite->getLocalZOrder());
+
+    if (!inOrder && !_freeSlots.empty())
+    {
+        // The quads have to be sorted anyway, so fill a hole left by a removed sprite instead of growing
+        index = _freeSlots.back();
+        _freeSlots.pop_back();
+        _descendants[index] = sprite;
+        _orderDirty         = true;
+    }
+    else
     {
-        setCapacity((capacity + 1) * 4 / 3);
+        // Holes are left alone so that in-order appends don't force a sort; they are dropped once there are enough
+        auto capacity = _quadBatch->getCapacity();
+
+        if (static_cast<ssize_t>(_descendants.size()) == capacity)
+        {
+            setCapacity((capacity + 1) * 4 / 3);
+        }
+
+        index = static_cast<ssize_t>(_descendants.size());
+        _descendants.push_back(sprite);
+
+        if (!inOrder)
+        {
+            _orderDirty = true;
+        }
     }
 
-    auto index = static_cast<ssize_t>(_descendants.size());
-    _descendants.push_back(sprite);
     sprite->setMaskedBatchIndex(index);
-    auto&& quad = sprite->getMaskedQuad();
-    _quadBatch->insertQuad(index, quad);
+    _quadBatch->setQuad(index, sprite->getMaskedQuad());
 
     // Recursively insert child sprites
     for (const auto& child : sprite->getChildren())
@@ -173,19 +246,27 @@ void MaskedSpriteBatchNode::insertSprite(MaskedSprite* sprite)
 
 void MaskedSpriteBatchNode::removeSprite(MaskedSprite* sprite)
 {
-    auto it = std::find(_descendants.begin(), _descendants.end(), sprite);
-    AXASSERT(it != _descendants.end(), "Sprite must be a descendant of this batch");
+    auto index = sprite->getMaskedBatchIndex();
+    AXASSERT(index >= 0 && index < static_cast<ssize_t>(_descendants.size()) && _descendants[index] == sprite,
+             "Sprite must be a descendant of this batch");
+
+    // Leave a hole instead of shifting every subsequent quad; holes are dropped the next time quads are sorted
+    _descendants[index] = nullptr;
+    _freeSlots.push_back(index);
+    _quadBatch->clearQuad(index);
+    sprite->setMaskedBatchNode(nullptr);
 
-    // Move all subsequent descendants one index to the left
-    for (auto next = std::next(it); next != _descendants.end(); next++)
+    if (sprite->_updateQueued)
     {
-        auto descendant = static_cast<MaskedSprite*>(*next);
-        descendant->setMaskedBatchIndex(descendant->getMaskedBatchIndex() - 1);
+        sprite->_updateQueued = false;
+        _pendingUpdates.erase(std::find(_pendingUpdates.begin(), _pendingUpdates.end(), sprite));
     }
 
-    _descendants.erase(it);
-    _quadBatch->removeQuad(sprite->getMaskedBatchIndex());
-    sprite->setMaskedBatchNode(nullptr);
+    if (_freeSlots.size() * COMPACT_RATIO > _descendants.size())
+    {
+        _orderDirty        = true;
+        _reorderChildDirty = true;
+    }
 
     // Recursively remove child sprites
     for (auto& child : sprite->getChildren())
@@ -201,22 +282,32 @@ void MaskedSpriteBatchNode::sortAllChildren()
         return;
     }
 
-    if (!_children.empty())
+    // Children that were only appended in order or removed don't need to be sorted
+    if (_orderDirty)
     {
-        sortNodes(_children);
+        ssize_t currentIndex = 0;
 
-        for (auto& child : _children)
+        if (!_children.empty())
         {
-            child->sortAllChildren();
-        }
+            sortNodes(_children);
 
-        ssize_t currentIndex = 0;
+            for (auto& child : _children)
+            {
+                child->sortAllChildren();
+            }
 
-        for (auto& child : _children)
-        {
-            auto sprite = static_cast<MaskedSprite*>(child);
-            updateBatchIndices(sprite, &currentIndex);
+            for (auto& child : _children)
+            {
+                auto sprite = static_cast<MaskedSprite*>(child);
+                updateBatchIndices(sprite, &currentIndex);
+            }
         }
+
+        // Every sprite now sits in front of the holes, so they can be dropped
+        _descendants.resize(currentIndex);
+        _freeSlots.clear();
+        _quadBatch->truncate(currentIndex);
+        _orderDirty = false;
     }
 
     _reorderChildDirty = false;
@@ -291,12 +382,19 @@ void MaskedSpriteBatchNode::swapBatchIndices(ssize_t oldIndex, ssize_t newIndex)
              "Index is out of bounds");
     auto quads = _quadBatch->getQuads();
     std::swap(quads[oldIndex], quads[newIndex]);
-    _quadBatch->setDirty(true);
-    auto oldIt = std::next(_descendants.begin(), oldIndex);
-    auto newIt = std::next(_descendants.begin(), newIndex);
-    (*newIt)->setMaskedBatchIndex(oldIndex);
-    (*oldIt)->setMaskedBatchIndex(newIndex);
-    std::swap(*oldIt, *newIt);
+    _quadBatch->markDirty(MIN(oldIndex, newIndex), MAX(oldIndex, newIndex) + 1);
+    auto oldSprite = _descendants[oldIndex];
+    auto newSprite = _descendants[newIndex];
+
+    // The target may be a hole
+    if (newSprite)
+    {
+        newSprite->setMaskedBatchIndex(oldIndex);
+    }
+
+    oldSprite->setMaskedBatchIndex(newIndex);
+    _descendants[oldIndex] = newSprite;
+    _descendants[newIndex] = oldSprite;
 }
 
 bool MaskedSpriteBatchNode::setCapacity(ssize_t capacity)
@@ -30,6 +30,7 @@ public:
     void addChild(ax::Node* child, int zOrder, std::string_view name) override;
     void removeChild(ax::Node* child, bool cleanup = true) override;
     void removeAllChildrenWithCleanup(bool cleanup = true) override;
+    void reorderChild(ax::Node* child, int zOrder) override;
     void sortAllChildren() override;
 
     bool setCapacity(ssize_t capacity);
@@ -47,6 +48,7 @@ private:
     friend class MaskedSprite;
 
     void updateSprite(MaskedSprite* sprite);
+    void queueSpriteUpdate(MaskedSprite* sprite);
     void insertSprite(MaskedSprite* sprite);
     void removeSprite(MaskedSprite* sprite);
 
@@ -58,7 +60,10 @@ private:
     ax::BlendFunc _blendFunc;
     MaskedQuadBatch* _quadBatch;
     MaskedQuadCommand _quadCommand;
-    std::vector<MaskedSprite*> _descendants;
+    std::vector<MaskedSprite*> _descendants;     // Indexed by batch index; nullptr for free slots
+    std::vector<ssize_t> _freeSlots;             // Batch indices of removed sprites
+    std::vector<MaskedSprite*> _pendingUpdates;  // Top-level sprites with changes that haven't been transformed yet
+    bool _orderDirty;                            // Quads are no longer in child order
 };
 
 }  // namespace opendw
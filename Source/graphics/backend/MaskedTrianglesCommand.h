@@ -40,10 +40,12 @@ public:
     void updateProgramState();
     void populateBuffers();
 
+protected:
+    Triangles _triangles;
+
 private:
     inline static ax::Program* sProgram;
 
-    Triangles _triangles;
     ax::backend::TextureBackend* _texture;
     ax::backend::TextureBackend* _maskTexture;
     ax::backend::UniformLocation _textureLocation;
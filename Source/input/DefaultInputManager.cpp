@@ -457,6 +457,9 @@ void DefaultInputManager::onKeyPressed(KeyCode keyCode, Event* event)
     case KeyCode::KEY_F4:
         _player->respawn();  // TODO: chat command
         break;
+    case KeyCode::KEY_F5:
+        lightmapper->verifyBands();
+        break;
     case KeyCode::KEY_ENTER:
         if (_keysPressed.contains(KeyCode::KEY_ALT))
         {
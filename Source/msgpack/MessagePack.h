@@ -3,6 +3,7 @@
 
 #include "msgpack/MessagePackPacker.h"
 #include "msgpack/MessagePackParser.h"
+#include "msgpack/MessagePackReader.h"
 
 namespace opendw::msgpack
 {
@@ -12,6 +13,9 @@ enum class DataType : uint8_t
     NIL        = 0xC0,
     BOOL_FALSE = 0xC2,
     BOOL_TRUE  = 0xC3,
+    BIN_8      = 0xC4,
+    BIN_16     = 0xC5,
+    BIN_32     = 0xC6,
     FLOAT_32   = 0xCA,
     FLOAT_64   = 0xCB,
     UINT_8     = 0xCC,
@@ -0,0 +1,377 @@
+#include "MessagePackReader.h"
+
+#include "msgpack/MessagePack.h"
+
+#define POS_FIXINT_MASK      0b10000000
+#define NEG_FIXINT_MASK      0b11100000
+#define FIXSTRING_MASK       0b11100000
+#define FIXSTRING_BITS       0b10100000
+#define FIXSTRING_LEN_BITS   0b00011111
+#define FIXMAP_MASK          0b11110000
+#define FIXMAP_BITS          0b10000000
+#define FIXMAP_LEN_BITS      0b00001111
+#define FIXARRAY_MASK        0b11110000
+#define FIXARRAY_BITS        0b10010000
+#define FIXARRAY_LEN_BITS    0b00001111
+#define IS_POS_FIXINT(token) (token & POS_FIXINT_MASK) == 0
+#define IS_NEG_FIXINT(token) (token & NEG_FIXINT_MASK) == NEG_FIXINT_MASK
+#define IS_FIXSTRING(token)  (token & FIXSTRING_MASK) == FIXSTRING_BITS
+#define IS_FIXMAP(token)     (token & FIXMAP_MASK) == FIXMAP_BITS
+#define IS_FIXARRAY(token)   (token & FIXARRAY_MASK) == FIXARRAY_BITS
+
+namespace opendw::msgpack
+{
+
+uint32_t MessagePackReader::readArrayHeader()
+{
+    auto token = readUInt8();
+
+    if (IS_FIXARRAY(token))
+    {
+        return token & FIXARRAY_LEN_BITS;
+    }
+
+    auto type = static_cast<DataType>(token);
+
+    switch (type)
+    {
+    case DataType::ARRAY_32:
+        return readUInt32();
+    case DataType::ARRAY_16:
+        return readUInt16();
+    default:
+        throwInvalidType("ARRAY", token);
+    }
+}
+
+uint32_t MessagePackReader::readMapHeader()
+{
+    auto token = readUInt8();
+
+    if (IS_FIXMAP(token))
+    {
+        return token & FIXMAP_LEN_BITS;
+    }
+
+    auto type = static_cast<DataType>(token);
+
+    switch (type)
+    {
+    case DataType::MAP_32:
+        return readUInt32();
+    case DataType::MAP_16:
+        return readUInt16();
+    default:
+        throwInvalidType("MAP", token);
+    }
+}
+
+bool MessagePackReader::readBool()
+{
+    auto token = readUInt8();
+    auto type  = static_cast<DataType>(token);
+
+    switch (type)
+    {
+    case DataType::BOOL_FALSE:
+        return false;
+    case DataType::BOOL_TRUE:
+        return true;
+    default:
+        throwInvalidType("BOOL", token);
+    }
+}
+
+uint64_t MessagePackReader::readUInt()
+{
+    auto token = readUInt8();
+
+    if (IS_POS_FIXINT(token))
+    {
+        return token;
+    }
+
+    auto type = static_cast<DataType>(token);
+
+    switch (type)
+    {
+    case DataType::UINT_8:
+        return readUInt8();
+    case DataType::UINT_16:
+        return readUInt16();
+    case DataType::UINT_32:
+        return readUInt32();
+    case DataType::UINT_64:
+        return readUInt64();
+    default:
+        throwInvalidType("UINT", token);
+    }
+}
+
+int64_t MessagePackReader::readInt()
+{
+    auto token = readUInt8();
+
+    if (IS_POS_FIXINT(token) || IS_NEG_FIXINT(token))
+    {
+        return static_cast<int8_t>(token);
+    }
+
+    auto type = static_cast<DataType>(token);
+
+    switch (type)
+    {
+    case DataType::UINT_8:
+        return readUInt8();
+    case DataType::UINT_16:
+        return readUInt16();
+    case DataType::UINT_32:
+        return readUInt32();
+    case DataType::UINT_64:
+    {
+        auto value = readUInt64();
+
+        if (value > INT64_MAX)
+        {
+            throw ParseException("INT_64 value is out of range");
+        }
+
+        return value;
+    }
+    case DataType::INT_8:
+        return static_cast<int8_t>(readUInt8());
+    case DataType::INT_16:
+        return static_cast<int16_t>(readUInt16());
+    case DataType::INT_32:
+        return static_cast<int32_t>(readUInt32());
+    case DataType::INT_64:
+        return static_cast<int64_t>(readUInt64());
+    default:
+        throwInvalidType("INT", token);
+    }
+}
+
+std::string_view MessagePackReader::readStringView()
+{
+    auto token      = readUInt8();
+    uint32_t length = 0;
+
+    if (IS_FIXSTRING(token))
+    {
+        length = token & FIXSTRING_LEN_BITS;
+    }
+    else
+    {
+        auto type = static_cast<DataType>(token);
+
+        switch (type)
+        {
+        case DataType::STRING_32:
+            length = readUInt32();
+            break;
+        case DataType::STRING_16:
+            length = readUInt16();
+            break;
+        default:
+            throwInvalidType("STRING", token);
+        }
+    }
+
+    auto bytes = readBytes(length);
+    return std::string_view(reinterpret_cast<const char*>(bytes), length);
+}
+
+std::span<const uint8_t> MessagePackReader::readBinView()
+{
+    auto token      = readUInt8();
+    auto type       = static_cast<DataType>(token);
+    uint32_t length = 0;
+
+    switch (type)
+    {
+    case DataType::BIN_32:
+        length = readUInt32();
+        break;
+    case DataType::BIN_16:
+        length = readUInt16();
+        break;
+    case DataType::BIN_8:
+        length = readUInt8();
+        break;
+    default:
+        throwInvalidType("BIN", token);
+    }
+
+    return std::span<const uint8_t>(readBytes(length), length);
+}
+
+void MessagePackReader::readUInt32Array(uint32_t* output, size_t count)
+{
+    auto length = readArrayHeader();
+
+    if (length != count)
+    {
+        throw ParseException(std::format("Expected array of length {} but got {}", count, length));
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto value = readUInt();
+
+        if (value > UINT32_MAX)
+        {
+            throw ParseException("UINT_32 value is out of range");
+        }
+
+        output[i] = static_cast<uint32_t>(value);
+    }
+}
+
+void MessagePackReader::skipValue()
+{
+    auto token = readUInt8();
+
+    if (IS_POS_FIXINT(token) || IS_NEG_FIXINT(token))
+    {
+        return;
+    }
+    else if (IS_FIXSTRING(token))
+    {
+        readBytes(token & FIXSTRING_LEN_BITS);
+        return;
+    }
+    else if (IS_FIXMAP(token))
+    {
+        for (uint32_t i = 0; i < (token & FIXMAP_LEN_BITS) * 2u; i++)
+        {
+            skipValue();
+        }
+
+        return;
+    }
+    else if (IS_FIXARRAY(token))
+    {
+        for (uint32_t i = 0; i < (token & FIXARRAY_LEN_BITS); i++)
+        {
+            skipValue();
+        }
+
+        return;
+    }
+
+    auto type = static_cast<DataType>(token);
+
+    switch (type)
+    {
+    case DataType::NIL:
+    case DataType::BOOL_FALSE:
+    case DataType::BOOL_TRUE:
+        break;
+    case DataType::UINT_8:
+    case DataType::INT_8:
+        readBytes(1);
+        break;
+    case DataType::UINT_16:
+    case DataType::INT_16:
+        readBytes(2);
+        break;
+    case DataType::FLOAT_32:
+    case DataType::UINT_32:
+    case DataType::INT_32:
+        readBytes(4);
+        break;
+    case DataType::FLOAT_64:
+    case DataType::UINT_64:
+    case DataType::INT_64:
+        readBytes(8);
+        break;
+    case DataType::BIN_8:
+        readBytes(readUInt8());
+        break;
+    case DataType::BIN_16:
+    case DataType::STRING_16:
+        readBytes(readUInt16());
+        break;
+    case DataType::BIN_32:
+    case DataType::STRING_32:
+        readBytes(readUInt32());
+        break;
+    case DataType::MAP_16:
+    case DataType::MAP_32:
+    {
+        _position--;  // Let readMapHeader consume the token
+        auto length = (uint64_t)readMapHeader() * 2;
+
+        for (uint64_t i = 0; i < length; i++)
+        {
+            skipValue();
+        }
+
+        break;
+    }
+    case DataType::ARRAY_16:
+    case DataType::ARRAY_32:
+    {
+        _position--;  // Let readArrayHeader consume the token
+        auto length = readArrayHeader();
+
+        for (uint32_t i = 0; i < length; i++)
+        {
+            skipValue();
+        }
+
+        break;
+    }
+    default:
+        throw ParseException(std::format("Unexpected token: 0x{:X}", token));
+    }
+}
+
+uint8_t MessagePackReader::readUInt8()
+{
+    ensureEnoughBytes(1);
+    return _input[_position++];
+}
+
+uint16_t MessagePackReader::readUInt16()
+{
+    auto bytes = readBytes(2);
+    return (uint16_t)(bytes[0] << 8 | bytes[1]);
+}
+
+uint32_t MessagePackReader::readUInt32()
+{
+    auto bytes = readBytes(4);
+    return (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 | (uint32_t)bytes[2] << 8 | bytes[3];
+}
+
+uint64_t MessagePackReader::readUInt64()
+{
+    uint64_t high = readUInt32();
+    return high << 32 | readUInt32();
+}
+
+const uint8_t* MessagePackReader::readBytes(size_t length)
+{
+    ensureEnoughBytes(length);
+    auto bytes = _input + _position;
+    _position += length;
+    return bytes;
+}
+
+void MessagePackReader::ensureEnoughBytes(size_t length) const
+{
+    if (length > _length - _position)
+    {
+        throw ParseException("Unexpected end of input");
+    }
+}
+
+void MessagePackReader::throwInvalidType(const char* expected, uint8_t receivedToken) const
+{
+    auto message =
+        std::format("Encountered unexpected token 0x{:X} while trying to read {}", receivedToken, expected);
+    throw ParseException(message);
+}
+
+}  // namespace opendw::msgpack
@@ -0,0 +1,68 @@
+#ifndef __MESSAGE_PACK_READER_H__
+#define __MESSAGE_PACK_READER_H__
+
+#include <span>
+
+#include "axmol.h"
+
+#include "msgpack/MessagePackParser.h"
+
+namespace opendw::msgpack
+{
+
+/*
+ * Pull-style counterpart to MessagePackParser.
+ * Values are decoded one at a time as the caller asks for them, so large payloads can be read straight into their
+ * final destination without building a ValueVector first. Strings and binary data are returned as views into the
+ * input buffer and are only valid for as long as it is.
+ */
+class MessagePackReader
+{
+public:
+    MessagePackReader(const uint8_t* input, size_t length) : _input(input), _length(length), _position(0) {}
+
+    /* @return The number of elements in the array that follows. */
+    uint32_t readArrayHeader();
+
+    /* @return The number of key-value pairs in the map that follows. */
+    uint32_t readMapHeader();
+
+    bool readBool();
+
+    uint64_t readUInt();
+    int64_t readInt();
+
+    std::string_view readStringView();
+    std::span<const uint8_t> readBinView();
+
+    /*
+     * Reads an array of exactly `count` unsigned integers into `output`.
+     * Throws if the array has a different length or if any of its elements does not fit in 32 bits.
+     */
+    void readUInt32Array(uint32_t* output, size_t count);
+
+    /* Skips over the next value, including all of its children if it is an array or map. */
+    void skipValue();
+
+    bool isAtEnd() const { return _position >= _length; }
+    size_t getPosition() const { return _position; }
+
+private:
+    uint8_t readUInt8();
+    uint16_t readUInt16();
+    uint32_t readUInt32();
+    uint64_t readUInt64();
+
+    const uint8_t* readBytes(size_t length);
+
+    void ensureEnoughBytes(size_t length) const;
+    void throwInvalidType(const char* expected, uint8_t receivedToken) const;
+
+    const uint8_t* _input;
+    size_t _length;
+    size_t _position;
+};
+
+}  // namespace opendw::msgpack
+
+#endif  // __MESSAGE_PACK_READER_H__
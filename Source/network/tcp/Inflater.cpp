@@ -0,0 +1,80 @@
+#include "Inflater.h"
+
+#define INITIAL_BUFFER_SIZE 256 * 1024         // 256 KB
+#define MAX_BUFFER_SIZE     256 * 1024 * 1024  // 256 MB
+#define WINDOW_BITS         15 + 32            // Detect gzip or zlib header automatically
+
+namespace opendw
+{
+
+Inflater::Inflater()
+{
+    _stream      = {};
+    _initialized = inflateInit2(&_stream, WINDOW_BITS) == Z_OK;
+    _output.resize(INITIAL_BUFFER_SIZE);
+
+    if (!_initialized)
+    {
+        AXLOGE("[Inflater] Failed to initialize z_stream");
+    }
+}
+
+Inflater::~Inflater()
+{
+    if (_initialized)
+    {
+        inflateEnd(&_stream);
+    }
+}
+
+bool Inflater::inflate(const uint8_t* input, size_t length)
+{
+    if (!_initialized || inflateReset(&_stream) != Z_OK)
+    {
+        return false;
+    }
+
+    _outputLength     = 0;
+    _stream.next_in   = const_cast<Bytef*>(input);
+    _stream.avail_in  = static_cast<uInt>(length);
+    _stream.next_out  = _output.data();
+    _stream.avail_out = static_cast<uInt>(_output.size());
+
+    while (true)
+    {
+        auto result = ::inflate(&_stream, Z_NO_FLUSH);
+
+        if (result == Z_STREAM_END)
+        {
+            _outputLength = _stream.total_out;
+            return true;
+        }
+
+        if (result != Z_OK && result != Z_BUF_ERROR)
+        {
+            AXLOGW("[Inflater] Inflate failed: {}", _stream.msg ? _stream.msg : "unknown error");
+            return false;
+        }
+
+        if (_stream.avail_out > 0)
+        {
+            // No progress can be made with space left over, so the input must be truncated
+            AXLOGW("[Inflater] Unexpected end of compressed input");
+            return false;
+        }
+
+        // Out of space; double the buffer and continue where we left off
+        if (_output.size() >= MAX_BUFFER_SIZE)
+        {
+            AXLOGW("[Inflater] Inflated payload exceeds {} bytes", MAX_BUFFER_SIZE);
+            return false;
+        }
+
+        auto written = _output.size();
+        _output.resize(written * 2);
+        _stream.next_out  = _output.data() + written;
+        _stream.avail_out = static_cast<uInt>(_output.size() - written);
+    }
+}
+
+}  // namespace opendw
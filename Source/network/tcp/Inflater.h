@@ -0,0 +1,46 @@
+#ifndef __INFLATER_H__
+#define __INFLATER_H__
+
+#include "axmol.h"
+#include "zlib.h"
+
+namespace opendw
+{
+
+/*
+ * Reusable gzip/zlib inflater.
+ * A single z_stream is kept alive and reset between payloads, and output is written straight into an internal buffer
+ * that only ever grows, so inflating a payload allocates nothing once the buffer has reached its working size.
+ */
+class Inflater
+{
+public:
+    Inflater();
+    ~Inflater();
+
+    Inflater(const Inflater&)            = delete;
+    Inflater& operator=(const Inflater&) = delete;
+
+    /*
+     * Inflates the input into the internal buffer.
+     * @return Whether the input was a complete, valid stream. Output is only valid if this returns true.
+     */
+    bool inflate(const uint8_t* input, size_t length);
+
+    /* @return The output of the last successful call to inflate. Valid until the next call. */
+    uint8_t* getOutput() { return _output.data(); }
+    size_t getOutputLength() const { return _outputLength; }
+
+    /* @return The current size of the output buffer. */
+    size_t getCapacity() const { return _output.size(); }
+
+private:
+    z_stream _stream;
+    std::vector<uint8_t> _output;
+    size_t _outputLength = 0;
+    bool _initialized    = false;
+};
+
+}  // namespace opendw
+
+#endif  // __INFLATER_H__
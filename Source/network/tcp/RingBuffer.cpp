@@ -0,0 +1,67 @@
+#include "RingBuffer.h"
+
+namespace opendw
+{
+
+RingBuffer::RingBuffer(size_t initialCapacity)
+{
+    grow(initialCapacity);
+}
+
+void RingBuffer::write(const uint8_t* data, size_t length)
+{
+    if (size() + length > _storage.size())
+    {
+        grow(size() + length);
+    }
+
+    auto start = _writePosition & _mask;
+    auto first = MIN(length, _storage.size() - start);
+    std::copy(data, data + first, _storage.begin() + start);
+    std::copy(data + first, data + length, _storage.begin());
+    _writePosition += length;
+}
+
+uint8_t* RingBuffer::linearize(size_t length)
+{
+    AX_ASSERT(length <= size());
+    auto start = _readPosition & _mask;
+
+    if (start + length <= _storage.size())
+    {
+        return _storage.data() + start;
+    }
+
+    // Range wraps around, so stitch both halves together
+    auto first = _storage.size() - start;
+    _scratch.resize(length);
+    std::copy(_storage.begin() + start, _storage.end(), _scratch.begin());
+    std::copy(_storage.begin(), _storage.begin() + (length - first), _scratch.begin() + first);
+    return _scratch.data();
+}
+
+void RingBuffer::grow(size_t minimumCapacity)
+{
+    size_t capacity = MAX(_storage.size(), 1);
+
+    while (capacity < minimumCapacity)
+    {
+        capacity <<= 1;
+    }
+
+    // Unwrap the unread data to the start of the new storage so the cursors can be rebased
+    std::vector<uint8_t> storage(capacity);
+    auto length = size();
+
+    if (length > 0)
+    {
+        std::copy_n(linearize(length), length, storage.begin());
+    }
+
+    _storage       = std::move(storage);
+    _mask          = capacity - 1;
+    _readPosition  = 0;
+    _writePosition = length;
+}
+
+}  // namespace opendw
@@ -0,0 +1,54 @@
+#ifndef __RING_BUFFER_H__
+#define __RING_BUFFER_H__
+
+#include "axmol.h"
+
+namespace opendw
+{
+
+/*
+ * Growable byte ring buffer with separate read and write cursors.
+ * Data is consumed in place; bytes that wrap around the end of the storage are only copied into a linear scratch
+ * buffer when a caller asks for them as a contiguous range.
+ */
+class RingBuffer
+{
+public:
+    explicit RingBuffer(size_t initialCapacity);
+
+    /* Appends data at the write cursor, growing the storage if it doesn't fit. */
+    void write(const uint8_t* data, size_t length);
+
+    /* @return The byte at the specified offset from the read cursor. */
+    uint8_t peek(size_t offset) const { return _storage[(_readPosition + offset) & _mask]; }
+
+    /*
+     * @return A pointer to the next `length` unread bytes as a contiguous range.
+     * Points into the storage directly unless the range wraps around, in which case it is copied into a scratch
+     * buffer first. The pointer is invalidated by the next call to write or linearize.
+     */
+    uint8_t* linearize(size_t length);
+
+    /* Advances the read cursor. */
+    void consume(size_t length) { _readPosition += length; }
+
+    void clear() { _readPosition = _writePosition = 0; }
+
+    /* @return The number of unread bytes. */
+    size_t size() const { return _writePosition - _readPosition; }
+
+    size_t getCapacity() const { return _storage.size(); }
+
+private:
+    void grow(size_t minimumCapacity);
+
+    std::vector<uint8_t> _storage;  // Size is always a power of two
+    std::vector<uint8_t> _scratch;
+    size_t _mask          = 0;
+    size_t _readPosition  = 0;  // Absolute; masked when indexing
+    size_t _writePosition = 0;  // Absolute; masked when indexing
+};
+
+}  // namespace opendw
+
+#endif  // __RING_BUFFER_H__
@@ -8,10 +8,12 @@
 #include "util/StringUtil.h"
 #include "GameManager.h"
 
-#define READ_BUFFER_SIZE    512 * 1024       // 512 KB
-#define INFLATE_BUFFER_SIZE 4 * 1024 * 1024  // 4 MB
+#define READ_BUFFER_SIZE    512 * 1024       // 512 KB; initial size, grows as needed
+#define MAX_PAYLOAD_LENGTH  64 * 1024 * 1024  // 64 MB
 #define CHANNEL_INDEX       0
 #define HEADER_LENGTH       5
+#define EVENT_QUEUE_SIZE    4096
+#define WORKER_IDLE_TIME    std::chrono::milliseconds(1)
 
 USING_NS_AX;
 using namespace yasio;
@@ -21,16 +23,11 @@ namespace opendw
 
 TcpClient::~TcpClient()
 {
+    stop();
     AX_SAFE_DELETE(_service);
-    AX_SAFE_DELETE_ARRAY(_readBuffer);
-    AX_SAFE_DELETE_ARRAY(_inflateBuffer);
 }
 
-TcpClient::TcpClient() : Object()
-{
-    _readBuffer    = new uint8_t[READ_BUFFER_SIZE];
-    _inflateBuffer = new uint8_t[INFLATE_BUFFER_SIZE];
-}
+TcpClient::TcpClient() : Object(), _readBuffer(READ_BUFFER_SIZE), _events(EVENT_QUEUE_SIZE) {}
 
 void TcpClient::connect(const char* address, uint16_t port)
 {
@@ -60,10 +57,30 @@ void TcpClient::connect(const char* address, uint16_t port)
         };
     });
     _service->open(CHANNEL_INDEX, YCK_TCP_CLIENT);
+    _running = true;
+    _worker  = std::thread(&TcpClient::runWorker, this);
 }
 
 void TcpClient::stop()
 {
+    _running = false;
+
+    if (_worker.joinable())
+    {
+        _worker.join();
+    }
+
+    // Discard anything the worker thread produced that the main thread didn't get to
+    NetworkEvent event;
+
+    while (_events.tryPop(event))
+    {
+        AX_SAFE_RELEASE(event.command);
+    }
+
+    _open      = false;
+    _transport = nullptr;
+
     if (_service)
     {
         if (_service->is_running())
@@ -78,9 +95,51 @@ void TcpClient::stop()
 
 void TcpClient::dispatch()
 {
-    if (_service)
+    NetworkEvent event;
+
+    while (_events.tryPop(event))
+    {
+        switch (event.kind)
+        {
+        case NetworkEvent::Kind::OPEN:
+            onChannelOpened(event.transport);
+            break;
+        case NetworkEvent::Kind::CLOSE:
+            onChannelClosed();
+            break;
+        case NetworkEvent::Kind::COMMAND:
+            event.command->autorelease();
+            GameManager::getInstance()->enqueueCommand(event.command);
+            break;
+        }
+    }
+}
+
+void TcpClient::runWorker()
+{
+    while (_running)
     {
         _service->dispatch();
+        std::this_thread::sleep_for(WORKER_IDLE_TIME);
+    }
+}
+
+void TcpClient::pushEvent(const NetworkEvent& event)
+{
+    // Wait for the main thread to catch up if it has fallen far behind
+    while (!_events.tryPush(event))
+    {
+        if (!_running)
+        {
+            if (event.command)
+            {
+                event.command->release();
+            }
+
+            return;
+        }
+
+        std::this_thread::yield();
     }
 }
 
@@ -126,22 +185,24 @@ void TcpClient::processPacket(uint8_t ident, uint8_t* payload, uint32_t length)
         return;
     }
 
-    command->autorelease();
+    auto& stats = _commandStats[ident];
+    auto start  = utils::gettime();
+    stats.count++;
+    stats.bytes += length;
 
     // Inflate payload if command is expected to be compressed
     if (command->isCompressed())
     {
-        auto buf = ZipUtils::decompressGZ(payload, length);
-
-        if (buf.length() > INFLATE_BUFFER_SIZE)
+        if (!_inflater.inflate(payload, length))
         {
-            AXLOGW("[TcpClient] Uncompressed payload length ({}) exceeds buffer size!", buf.length());
+            AXLOGW("[TcpClient] Failed to inflate payload of command {}", static_cast<int>(ident));
+            command->release();
             return;
         }
 
-        std::copy(buf.begin(), buf.end(), _inflateBuffer);
-        payload = _inflateBuffer;
-        length  = buf.length();
+        payload = _inflater.getOutput();
+        length  = _inflater.getOutputLength();
+        stats.inflatedBytes += length;
     }
 
     command->initWithData(payload, length);
@@ -153,50 +214,65 @@ void TcpClient::processPacket(uint8_t ident, uint8_t* payload, uint32_t length)
         auto name    = static_cast<int>(ident);  // TODO: use class name for easier debugging
         AXLOGE("------------------\nCommand error in {}: {}\n------------------\n", name,
                string_util::join(errors, "\n"));
+        command->release();
     }
     else
     {
-        GameManager::getInstance()->enqueueCommand(command);
+        NetworkEvent event;
+        event.command = command;
+        pushEvent(event);
     }
+
+    stats.decodeTime += static_cast<uint64_t>((utils::gettime() - start) * 1000000);
 }
 
-void TcpClient::onPacket(event_ptr& event)
+void TcpClient::logCommandStats() const
 {
-    const auto& packet = std::move(event->packet());
-    auto packetSize    = packet.size();
-
-    if (_bytesRead + packetSize > READ_BUFFER_SIZE)
+    for (size_t i = 0; i < _commandStats.size(); i++)
     {
-        AXLOGE("[TcpClient] Read buffer limit reached!");
-        _bytesRead     = 0;
-        _header.ident  = 0;
-        _header.length = 0;
-        return;
+        auto& stats = _commandStats[i];
+
+        if (stats.count > 0)
+        {
+            AXLOGI("[TcpClient] Command {}: count {}, bytes {}, inflated {}, decode time {}us", i, stats.count.load(),
+                   stats.bytes.load(), stats.inflatedBytes.load(), stats.decodeTime.load());
+        }
     }
+}
 
-    std::copy(packet.begin(), packet.end(), _readBuffer + _bytesRead);
-    _bytesRead += packetSize;
+void TcpClient::onPacket(event_ptr& event)
+{
+    const auto& packet = std::move(event->packet());
+    _readBuffer.write(reinterpret_cast<const uint8_t*>(packet.data()), packet.size());
 
     while (true)
     {
         // Try to read next packet header
-        // TODO: invalid data might make it wait forever (or at least until the read buffer is full)
-        if (!_waitingForPayload && _bytesRead >= HEADER_LENGTH)
+        if (!_waitingForPayload && _readBuffer.size() >= HEADER_LENGTH)
         {
-            _header.ident  = _readBuffer[0];
-            _header.length = _readBuffer[1] | (_readBuffer[2] << 8) | (_readBuffer[3] << 16) | (_readBuffer[4] << 24);
+            _header.ident  = _readBuffer.peek(0);
+            _header.length = _readBuffer.peek(1) | (_readBuffer.peek(2) << 8) | (_readBuffer.peek(3) << 16) |
+                             (_readBuffer.peek(4) << 24);
+            _readBuffer.consume(HEADER_LENGTH);
             _waitingForPayload = true;
+
+            // Invalid data would otherwise make it wait (and buffer) forever
+            if (_header.length > MAX_PAYLOAD_LENGTH)
+            {
+                AXLOGE("[TcpClient] Payload length ({}) exceeds limit!", _header.length);
+                _readBuffer.clear();
+                _waitingForPayload = false;
+                return;
+            }
         }
 
         // Try to read and process packet payload
-        if (_waitingForPayload && _bytesRead >= HEADER_LENGTH + _header.length)
+        if (_waitingForPayload && _readBuffer.size() >= _header.length)
         {
-            auto payloadStart = _readBuffer + HEADER_LENGTH;
-            auto payloadEnd   = payloadStart + _header.length;
-            processPacket(_header.ident, payloadStart, _header.length);
-            _bytesRead -= HEADER_LENGTH;
-            _bytesRead -= _header.length;
-            std::copy(payloadEnd, payloadEnd + _bytesRead, _readBuffer);
+            // The payload can be used in place unless it wraps around the end of the buffer
+            auto payload = _readBuffer.linearize(_header.length);
+            processPacket(_header.ident, payload, _header.length);
+            _readBuffer.consume(_header.length);
             _waitingForPayload = false;
         }
         else
@@ -207,22 +283,39 @@ void TcpClient::onPacket(event_ptr& event)
 }
 
 void TcpClient::onOpen(event_ptr& event)
+{
+    NetworkEvent openEvent;
+    openEvent.kind      = NetworkEvent::Kind::OPEN;
+    openEvent.transport = event->transport();
+    pushEvent(openEvent);
+}
+
+void TcpClient::onClose(event_ptr& event)
+{
+    _readBuffer.clear();
+    _waitingForPayload = false;
+    NetworkEvent closeEvent;
+    closeEvent.kind = NetworkEvent::Kind::CLOSE;
+    pushEvent(closeEvent);
+}
+
+void TcpClient::onChannelOpened(yasio::transport_handle_t transport)
 {
     AXLOGI("[TcpClient] Channel opened!");
     _open        = true;
-    _transport   = event->transport();
+    _transport   = transport;
     auto game    = GameManager::getInstance();
     auto user    = game->getCurrentUser();
     auto details = map_util::mapOf("initial", game->getConfig() == nullptr);
     sendMessage(MessageIdent::AUTHENTICATE, GAME_VERSION, user.username, user.token, details);
 }
 
-void TcpClient::onClose(event_ptr& event)
+void TcpClient::onChannelClosed()
 {
     AXLOGI("[TcpClient] Channel closed!");
+    logCommandStats();
     _open      = false;
     _transport = nullptr;
-    _bytesRead = 0;
     GameManager::getInstance()->onDisconnected();
 }
 
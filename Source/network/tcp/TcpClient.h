@@ -1,25 +1,46 @@
 #ifndef __TCP_CLIENT_H__
 #define __TCP_CLIENT_H__
 
+#include <thread>
+
 #include "axmol.h"
 #include "yasio/yasio.hpp"
 
+#include "network/tcp/Inflater.h"
+#include "network/tcp/RingBuffer.h"
 #include "util/ArrayUtil.h"
+#include "util/SpscQueue.h"
 
 namespace opendw
 {
 
+class GameCommand;
 enum class MessageIdent : uint8_t;
 
+/*
+ * Network events are dispatched on a dedicated worker thread, which also inflates, unpacks and validates incoming
+ * commands. Finished commands and connection state changes are handed to the main thread through a lock-free queue
+ * that is drained by dispatch().
+ */
 class TcpClient : public ax::Object
 {
 public:
+    /* Traffic counters for a single command type. Written by the worker thread, safe to read from any thread. */
+    struct CommandStats
+    {
+        std::atomic<uint64_t> count         = 0;
+        std::atomic<uint64_t> bytes         = 0;  // Payload bytes as received
+        std::atomic<uint64_t> inflatedBytes = 0;  // Payload bytes after inflating; only counts compressed commands
+        std::atomic<uint64_t> decodeTime    = 0;  // Microseconds spent inflating, unpacking and validating
+    };
+
     ~TcpClient() override;
     TcpClient();
 
     void connect(const char* address, uint16_t port);
     void stop();
 
+    /* Main thread only. Hands any commands received by the worker thread over to the game. */
     void dispatch();
 
     template <typename... T>
@@ -33,13 +54,43 @@ public:
 
     void processPacket(uint8_t ident, uint8_t* payload, uint32_t length);
 
+    // Worker thread event handlers
     void onPacket(yasio::event_ptr& event);
     void onOpen(yasio::event_ptr& event);
     void onClose(yasio::event_ptr& event);
 
+    // Main thread event handlers
+    void onChannelOpened(yasio::transport_handle_t transport);
+    void onChannelClosed();
+
     bool isOpen() const { return _open; }
 
+    const CommandStats& getCommandStats(uint8_t ident) const { return _commandStats[ident]; }
+
+    /* Logs the counters of every command type that has been received at least once. */
+    void logCommandStats() const;
+
 private:
+    struct NetworkEvent
+    {
+        enum class Kind : uint8_t
+        {
+            OPEN,
+            CLOSE,
+            COMMAND
+        };
+
+        Kind kind                           = Kind::COMMAND;
+        GameCommand* command                = nullptr;  // Retained until it is picked up by the main thread
+        yasio::transport_handle_t transport = nullptr;
+    };
+
+    /* Worker thread only. */
+    void pushEvent(const NetworkEvent& event);
+
+    /* Worker thread loop; dispatches network events until the client is stopped. */
+    void runWorker();
+
     struct PacketHeader
     {
         uint8_t ident;
@@ -48,11 +99,14 @@ private:
 
     yasio::io_service* _service          = nullptr;
     yasio::transport_handle_t _transport = nullptr;
-    uint8_t* _readBuffer                 = nullptr;
-    uint8_t* _inflateBuffer              = nullptr;
-    size_t _bytesRead                    = 0;
     bool _waitingForPayload              = false;
     bool _open                           = false;
+    RingBuffer _readBuffer;  // Worker thread only
+    Inflater _inflater;      // Worker thread only
+    std::array<CommandStats, 256> _commandStats;
+    std::thread _worker;
+    std::atomic<bool> _running = false;
+    SpscQueue<NetworkEvent> _events;
 };
 
 }  // namespace opendw
@@ -91,6 +91,8 @@ void GameCommand::initWithData(const uint8_t* data, size_t length)
 
 bool GameCommand::validate()
 {
+    auto& matcher = validation::getDescriptorMatcher(getDataDescriptor());
+
     if (isCollection())
     {
         // Validate each element in the collection
@@ -101,13 +103,13 @@ bool GameCommand::validate()
             // Check if element is an array (collections elements have to be arrays)
             if (element.getType() == Value::Type::VECTOR)
             {
-                auto& array     = element.asValueVector();
-                auto descriptor = validation::createArrayDescriptor(array);
+                auto& array = element.asValueVector();
 
                 // Check if element matches the command data descriptor
-                if (!validation::validateDescriptor(descriptor, getDataDescriptor()))
+                if (!matcher.matches(array))
                 {
-                    addError(std::format("Collection data at index {} does not match descriptor:", i, descriptor));
+                    auto descriptor = validation::createArrayDescriptor(array);
+                    addError(std::format("Collection data at index {} does not match descriptor: {}", i, descriptor));
                 }
             }
             else
@@ -119,11 +121,10 @@ bool GameCommand::validate()
     }
     else
     {
-        auto descriptor = validation::createArrayDescriptor(_data);
-
         // Check if data matches the command descriptor
-        if (!validation::validateDescriptor(descriptor, getDataDescriptor()))
+        if (!matcher.matches(_data))
         {
+            auto descriptor = validation::createArrayDescriptor(_data);
             addError(std::format("Data does not match descriptor: {}", descriptor));
         }
     }
@@ -1,6 +1,7 @@
 #include "GameCommandBlocks.h"
 
 #include "graphics/WorldRenderer.h"
+#include "msgpack/MessagePack.h"
 #include "zone/BaseBlock.h"
 #include "zone/WorldZone.h"
 #include "GameManager.h"
@@ -12,6 +13,52 @@ USING_NS_AX;
 namespace opendw
 {
 
+void GameCommandBlocks::initWithData(const uint8_t* data, size_t length)
+{
+    size_t index = 0;
+
+    try
+    {
+        msgpack::MessagePackReader reader(data, length);
+        auto chunkCount = reader.readArrayHeader();
+
+        for (; index < chunkCount; index++)
+        {
+            if (reader.readArrayHeader() != 5)
+            {
+                throw msgpack::ParseException("Chunk array has wrong length");
+            }
+
+            Chunk chunk;
+            chunk.x      = static_cast<int32_t>(reader.readInt());
+            chunk.y      = static_cast<int32_t>(reader.readInt());
+            chunk.width  = static_cast<int32_t>(reader.readInt());
+            chunk.height = static_cast<int32_t>(reader.readInt());
+            chunk.offset = _blockData.size();
+
+            auto valueCount = (size_t)chunk.width * chunk.height * 3;
+
+            // Every value takes up at least one byte, so anything larger than the payload can't possibly be valid
+            if (chunk.width <= 0 || chunk.height <= 0 || valueCount > length)
+            {
+                throw msgpack::ParseException("Chunk has invalid dimensions");
+            }
+
+            _blockData.resize(chunk.offset + valueCount);
+            reader.readUInt32Array(&_blockData[chunk.offset], valueCount);
+            _chunks.push_back(chunk);
+        }
+    }
+    catch (msgpack::ParseException& ex)
+    {
+        addError(std::format("Collection data at index {} does not match descriptor: {}", index, ex.what()), true);
+        _chunks.clear();
+        _blockData.clear();
+    }
+
+    postUnpack();
+}
+
 void GameCommandBlocks::run()
 {
     auto zone     = GameManager::getInstance()->getZone();
@@ -25,14 +72,14 @@ void GameCommandBlocks::run()
             break;
         }
 
-        auto& chunk     = _data[_currentChunk].asValueVector();
-        auto x          = chunk[0].asInt();
-        auto y          = chunk[1].asInt();
-        auto width      = chunk[2].asInt();
-        auto height     = chunk[3].asInt();
-        auto& blocks    = chunk[4].asValueVector();
+        auto& chunk     = _chunks[_currentChunk];
+        auto x          = chunk.x;
+        auto y          = chunk.y;
+        auto width      = chunk.width;
+        auto height     = chunk.height;
+        auto blocks     = &_blockData[chunk.offset];
         auto blockCount = width * height;
-        AX_ASSERT(blocks.size() / 3 == blockCount);
+        auto changed    = 0;
 
         for (auto i = 0; i < blockCount; i++)
         {
@@ -40,7 +87,17 @@ void GameCommandBlocks::run()
             auto blockY = y + i / width;
             auto block  = zone->getBlockAt(blockX, blockY, true);
             AX_ASSERT(block);
-            block->setData(blocks, i);
+
+            // The server frequently resends chunks we already have, so only update blocks that actually changed
+            if (!block->hasData(blocks, i))
+            {
+                block->setData(blocks, i);
+                changed++;
+            }
+            else if (!block->isPlacing())
+            {
+                continue;  // Already rendered; nothing to do
+            }
 
             // 0x1000E1B32: Render immediately if block is visible
             if (renderer->isBlockInViewport(block))
@@ -49,13 +106,19 @@ void GameCommandBlocks::run()
             }
         }
 
+        // Compute wholeness & continuity in bulk rather than having every block gather its own neighbors
+        if (changed > 0)
+        {
+            zone->recomputeChunkEnvironments(x, y, width, height);
+        }
+
         zone->removePendingChunk(x, y);
     }
 }
 
 void GameCommandBlocks::postUnpack()
 {
-    _chunkCount   = _data.size();
+    _chunkCount   = _chunks.size();
     _currentChunk = 0;
 }
 
@@ -12,6 +12,12 @@ namespace opendw
 class GameCommandBlocks : public GameCommand
 {
 public:
+    /*
+     * Decodes the payload straight into a flat block data array instead of unpacking it into a ValueVector.
+     * The shape of each chunk is checked while decoding, so the descriptor is effectively validated here.
+     */
+    void initWithData(const uint8_t* data, size_t length) override;
+
     /* FUNC: GameCommandBlocks::run @ 0x1000E1952 */
     void run() override;
 
@@ -30,6 +36,17 @@ public:
     const char* getDataDescriptor() const override { return "NNNNA"; }
 
 private:
+    struct Chunk
+    {
+        int32_t x;
+        int32_t y;
+        int32_t width;
+        int32_t height;
+        size_t offset;  // Offset of the first block in _blockData
+    };
+
+    std::vector<Chunk> _chunks;
+    std::vector<uint32_t> _blockData;  // Base, back & front values of every block in every chunk
     size_t _chunkCount   = 0;  // GameCommandBlocks::chunkCount @ 0x100312F00
     size_t _currentChunk = 0;  // GameCommandBlocks::currentChunk @ 0x100312F08
 };
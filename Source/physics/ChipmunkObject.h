@@ -19,6 +19,13 @@ public:
     virtual void onRemovedFromSpace(ChipmunkSpace* space) {};
 
     virtual const ax::Vector<ChipmunkBaseObject*> getChipmunkObjects() = 0;
+
+    /* Position of this object in the children of the space it was added to, or -1. Maintained by ChipmunkSpace. */
+    void setSpaceIndex(ssize_t index) { _spaceIndex = index; }
+    ssize_t getSpaceIndex() const { return _spaceIndex; }
+
+private:
+    ssize_t _spaceIndex = -1;
 };
 
 /*
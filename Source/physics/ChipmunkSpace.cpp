@@ -13,6 +13,12 @@ ChipmunkSpace::~ChipmunkSpace()
     freeSpace();
     AX_SAFE_RELEASE(_staticBody);
 
+    for (auto child : _children)
+    {
+        child->setSpaceIndex(-1);
+        child->release();
+    }
+
     for (auto handler : _collisionHandlers)
     {
         AX_SAFE_DELETE(handler);
@@ -165,7 +171,7 @@ void ChipmunkSpace::add(ChipmunkObject* object)
             add(child);
         }
 
-        _children.pushBack(object);
+        addChild(object);
         object->onAddedToSpace(this);
     }
 }
@@ -183,7 +189,7 @@ void ChipmunkSpace::remove(ChipmunkObject* object)
             remove(child);
         }
 
-        _children.eraseObject(object);
+        removeChild(object);
         object->onRemovedFromSpace(this);
     }
 }
@@ -227,25 +233,55 @@ void ChipmunkSpace::smartRemove(ChipmunkObject* object)
 void ChipmunkSpace::addBody(ChipmunkBody* body)
 {
     cpSpaceAddBody(_space, body->getBody());
-    _children.pushBack(body);
+    addChild(body);
 }
 
 void ChipmunkSpace::removeBody(ChipmunkBody* body)
 {
     cpSpaceRemoveBody(_space, body->getBody());
-    _children.eraseObject(body);
+    removeChild(body);
 }
 
 void ChipmunkSpace::addShape(ChipmunkShape* shape)
 {
     cpSpaceAddShape(_space, shape->getShape());
-    _children.pushBack(shape);
+    addChild(shape);
 }
 
 void ChipmunkSpace::removeShape(ChipmunkShape* shape)
 {
     cpSpaceRemoveShape(_space, shape->getShape());
-    _children.eraseObject(shape);
+    removeChild(shape);
+}
+
+void ChipmunkSpace::addChild(ChipmunkObject* object)
+{
+    if (object->getSpaceIndex() != -1)
+    {
+        return;
+    }
+
+    object->retain();
+    object->setSpaceIndex(_children.size());
+    _children.push_back(object);
+}
+
+void ChipmunkSpace::removeChild(ChipmunkObject* object)
+{
+    auto index = object->getSpaceIndex();
+
+    if (index == -1)
+    {
+        return;
+    }
+
+    AX_ASSERT(_children[index] == object);
+    auto last        = _children.back();
+    _children[index] = last;
+    last->setSpaceIndex(index);
+    _children.pop_back();
+    object->setSpaceIndex(-1);
+    object->release();
 }
 
 bool ChipmunkSpace::testSegmentQuery(const Point& from, const Point& to, float radius, cpShapeFilter filter)
@@ -107,9 +107,15 @@ public:
     ChipmunkBody* getStaticBody() const { return _staticBody; }
 
 private:
-    cpSpace* _space;                        // ChipmunkSpace::_space @ 0x1003124F8
-    ChipmunkBody* _staticBody;              // ChipmunkSpace::_staticBody @ 0x100312500
-    ax::Vector<ChipmunkObject*> _children;  // ChipmunkSpace::_children @ 0x1003124E8
+    /* Retains the object and stores it in the children of this space. Does nothing if it is already a child. */
+    void addChild(ChipmunkObject* object);
+
+    /* Releases the object and swaps the last child into its place. Does nothing if it isn't a child. */
+    void removeChild(ChipmunkObject* object);
+
+    cpSpace* _space;                         // ChipmunkSpace::_space @ 0x1003124F8
+    ChipmunkBody* _staticBody;               // ChipmunkSpace::_staticBody @ 0x100312500
+    std::vector<ChipmunkObject*> _children;  // ChipmunkSpace::_children @ 0x1003124E8
     std::vector<CollisionHandler*> _collisionHandlers;
 };
 
@@ -0,0 +1,75 @@
+#ifndef __RING_QUEUE_H__
+#define __RING_QUEUE_H__
+
+#include <vector>
+
+namespace opendw
+{
+
+/*
+ * Growable FIFO queue backed by a power-of-two ring buffer.
+ * Pushing and popping are O(1) and storage is reused, so a queue that is filled and drained every frame stops
+ * allocating once it has reached its working size.
+ */
+template <typename T>
+class RingQueue
+{
+public:
+    void push(const T& element)
+    {
+        if (_size == _elements.size())
+        {
+            grow();
+        }
+
+        _elements[(_head + _size) & _mask] = element;
+        _size++;
+    }
+
+    T& front() { return _elements[_head]; }
+    const T& front() const { return _elements[_head]; }
+
+    void pop()
+    {
+        _head = (_head + 1) & _mask;
+        _size--;
+    }
+
+    /* @return The element at the specified offset from the front of the queue. */
+    T& operator[](size_t index) { return _elements[(_head + index) & _mask]; }
+    const T& operator[](size_t index) const { return _elements[(_head + index) & _mask]; }
+
+    void clear()
+    {
+        _head = 0;
+        _size = 0;
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+private:
+    void grow()
+    {
+        auto capacity = _elements.empty() ? 64 : _elements.size() * 2;
+        std::vector<T> elements(capacity);
+
+        for (size_t i = 0; i < _size; i++)
+        {
+            elements[i] = std::move((*this)[i]);
+        }
+
+        _elements = std::move(elements);
+        _mask     = capacity - 1;
+        _head     = 0;
+    }
+
+    std::vector<T> _elements;
+    size_t _mask = 0;
+    size_t _head = 0;
+    size_t _size = 0;
+};
+
+}  // namespace opendw
+
+#endif  // __RING_QUEUE_H__
@@ -0,0 +1,79 @@
+#ifndef __SPSC_QUEUE_H__
+#define __SPSC_QUEUE_H__
+
+#include <atomic>
+#include <memory>
+
+namespace opendw
+{
+
+/*
+ * Bounded lock-free queue for handing elements from exactly one producer thread to exactly one consumer thread.
+ * The capacity is rounded up to a power of two.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(size_t capacity)
+    {
+        _capacity = 1;
+
+        while (_capacity < capacity)
+        {
+            _capacity <<= 1;
+        }
+
+        _mask     = _capacity - 1;
+        _elements = std::make_unique<T[]>(_capacity);
+    }
+
+    SpscQueue(const SpscQueue&)            = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /* Producer only. @return false if the queue is full. */
+    bool tryPush(const T& element)
+    {
+        auto tail = _tail.load(std::memory_order_relaxed);
+
+        if (tail - _head.load(std::memory_order_acquire) == _capacity)
+        {
+            return false;
+        }
+
+        _elements[tail & _mask] = element;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Consumer only. @return false if the queue is empty. */
+    bool tryPop(T& element)
+    {
+        auto head = _head.load(std::memory_order_relaxed);
+
+        if (head == _tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        element = std::move(_elements[head & _mask]);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* @return The number of queued elements. Only exact when called from either end while the other is idle. */
+    size_t size() const { return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire); }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    std::unique_ptr<T[]> _elements;
+    size_t _capacity;
+    size_t _mask;
+    alignas(64) std::atomic<size_t> _head = 0;  // Written by the consumer
+    alignas(64) std::atomic<size_t> _tail = 0;  // Written by the producer
+};
+
+}  // namespace opendw
+
+#endif  // __SPSC_QUEUE_H__
@@ -0,0 +1,106 @@
+#include "ThreadPool.h"
+
+namespace opendw
+{
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    _wakeCondition.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+ThreadPool::ThreadPool(size_t workerCount)
+{
+    _workers.reserve(workerCount);
+
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        _workers.emplace_back(&ThreadPool::runWorker, this);
+    }
+}
+
+void ThreadPool::run(size_t count, const Job& job)
+{
+    // Not worth waking anyone up for
+    if (count <= 1 || _workers.empty())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            job(i);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job      = &job;
+        _jobCount = count;
+        _nextJob  = 0;
+        _generation++;
+    }
+
+    _wakeCondition.notify_all();
+    runJobs(job, count);
+
+    // Every job has been claimed at this point, so only wait for the workers that are still busy with theirs
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCondition.wait(lock, [this] { return _activeWorkers == 0; });
+    _job      = nullptr;
+    _jobCount = 0;
+}
+
+void ThreadPool::runWorker()
+{
+    uint64_t generation = 0;
+
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _wakeCondition.wait(lock, [&] { return _stopping || _generation != generation; });
+
+        if (_stopping)
+        {
+            return;
+        }
+
+        generation = _generation;
+
+        // Woke up after the caller already finished all of the work
+        if (!_job)
+        {
+            continue;
+        }
+
+        auto job   = _job;
+        auto count = _jobCount;
+        _activeWorkers++;
+        lock.unlock();
+        runJobs(*job, count);
+        lock.lock();
+
+        if (--_activeWorkers == 0)
+        {
+            _doneCondition.notify_all();
+        }
+    }
+}
+
+void ThreadPool::runJobs(const Job& job, size_t count)
+{
+    for (auto index = _nextJob++; index < count; index = _nextJob++)
+    {
+        job(index);
+    }
+}
+
+}  // namespace opendw
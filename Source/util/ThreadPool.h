@@ -0,0 +1,53 @@
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opendw
+{
+
+/*
+ * Small fixed pool of worker threads for splitting per-frame work into independent jobs.
+ * The calling thread takes part in the work, and run() only returns once every job has finished.
+ */
+class ThreadPool
+{
+public:
+    typedef std::function<void(size_t)> Job;
+
+    ~ThreadPool();
+    explicit ThreadPool(size_t workerCount);
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /* Calls the job once for every index in [0, count) and waits for all of the calls to return. */
+    void run(size_t count, const Job& job);
+
+    /* @return The number of threads that jobs are spread across, including the calling thread. */
+    size_t getThreadCount() const { return _workers.size() + 1; }
+
+private:
+    void runWorker();
+    void runJobs(const Job& job, size_t count);
+
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _wakeCondition;
+    std::condition_variable _doneCondition;
+    const Job* _job              = nullptr;  // Only set while run() is in progress
+    size_t _jobCount             = 0;
+    std::atomic<size_t> _nextJob = 0;
+    uint64_t _generation         = 0;        // Bumped by every run() so that workers never pick up work twice
+    size_t _activeWorkers        = 0;
+    bool _stopping               = false;
+};
+
+}  // namespace opendw
+
+#endif  // __THREAD_POOL_H__
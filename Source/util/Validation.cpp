@@ -1,13 +1,124 @@
 #include "Validation.h"
 
-#include <regex>
 #include <sstream>
+#include <unordered_map>
+
+#define ANY_DESCRIPTOR_MASK 0x1F
 
 USING_NS_AX;
 
 namespace opendw::validation
 {
 
+static uint8_t getDescriptorMask(char descriptor)
+{
+    switch (descriptor)
+    {
+    case 'N':
+        return 1 << 0;
+    case 'S':
+        return 1 << 1;
+    case 'A':
+        return 1 << 2;
+    case 'D':
+        return 1 << 3;
+    case 'x':
+        return 1 << 4;
+    default:
+        return 0;
+    }
+}
+
+DescriptorMatcher::DescriptorMatcher(std::string_view pattern) : _empty(pattern.empty())
+{
+    for (size_t i = 0; i < pattern.size(); i++)
+    {
+        auto token   = pattern[i];
+        uint8_t mask = 0;
+
+        if (token == '.')
+        {
+            mask = ANY_DESCRIPTOR_MASK;
+        }
+        else if (token == '[')
+        {
+            // Combine everything up to the closing bracket into a single position
+            while (++i < pattern.size() && pattern[i] != ']')
+            {
+                mask |= getDescriptorMask(pattern[i]);
+            }
+        }
+        else
+        {
+            mask = getDescriptorMask(token);
+        }
+
+        AXASSERT(mask != 0, "Unsupported token in descriptor pattern");
+        _masks.push_back(mask);
+    }
+}
+
+bool DescriptorMatcher::matches(const ValueVector& array) const
+{
+    if (_empty)
+    {
+        return true;
+    }
+
+    if (array.size() != _masks.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < _masks.size(); i++)
+    {
+        if (!(_masks[i] & getDescriptorMask(getValueDescriptor(array[i]))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool DescriptorMatcher::matches(std::string_view descriptor) const
+{
+    if (_empty)
+    {
+        return true;
+    }
+
+    if (descriptor.size() != _masks.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < _masks.size(); i++)
+    {
+        if (!(_masks[i] & getDescriptorMask(descriptor[i])))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const DescriptorMatcher& getDescriptorMatcher(const char* pattern)
+{
+    // Patterns are string literals, so their address is enough to identify them.
+    // Each thread gets its own cache so that lookups don't need to be synchronized.
+    thread_local std::unordered_map<const char*, DescriptorMatcher> matchers;
+    auto it = matchers.find(pattern);
+
+    if (it == matchers.end())
+    {
+        it = matchers.emplace(pattern, DescriptorMatcher(pattern)).first;
+    }
+
+    return it->second;
+}
+
 char getValueDescriptor(const Value& value)
 {
     switch (value.getTypeFamily())
@@ -40,21 +151,14 @@ std::string createArrayDescriptor(const ValueVector& array)
     return result.str();
 }
 
-bool validateDescriptor(const std::string& descriptor, const std::string& validRegex)
+bool validateDescriptor(const std::string& descriptor, const char* pattern)
 {
-    if (validRegex.empty())
-    {
-        return true;
-    }
-
-    std::smatch match;
-    std::regex regex(validRegex);
-    return std::regex_match(descriptor, match, regex);
+    return getDescriptorMatcher(pattern).matches(descriptor);
 }
 
-bool validateArray(const ValueVector& array, const std::string& validRegex)
+bool validateArray(const ValueVector& array, const char* pattern)
 {
-    return validateDescriptor(createArrayDescriptor(array), validRegex);
+    return getDescriptorMatcher(pattern).matches(array);
 }
 
-}  // namespace opendw::value_util
+}  // namespace opendw::validation
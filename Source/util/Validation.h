@@ -6,12 +6,33 @@
 namespace opendw::validation
 {
 
+/*
+ * Precompiled descriptor pattern.
+ * Patterns are sequences of value descriptors (N, S, A, D, x), '.' for any value and bracketed sets such as [Nx].
+ * Each position is compiled into a bitmask of the descriptors it accepts, so matching is a single pass over the values.
+ */
+class DescriptorMatcher
+{
+public:
+    explicit DescriptorMatcher(std::string_view pattern);
+
+    bool matches(const ax::ValueVector& array) const;
+    bool matches(std::string_view descriptor) const;
+
+private:
+    std::vector<uint8_t> _masks;
+    bool _empty;  // Empty patterns accept anything
+};
+
+/* @return The matcher for the specified pattern, compiled on first use. Patterns are cached by address. */
+const DescriptorMatcher& getDescriptorMatcher(const char* pattern);
+
 char getValueDescriptor(const ax::Value& value);
 
 std::string createArrayDescriptor(const ax::ValueVector& array);
 
-bool validateDescriptor(const std::string& descriptor, const std::string& validRegex);
-bool validateArray(const ax::ValueVector& array, const std::string& validRegex);
+bool validateDescriptor(const std::string& descriptor, const char* pattern);
+bool validateArray(const ax::ValueVector& array, const char* pattern);
 
 }  // namespace opendw::validation
 
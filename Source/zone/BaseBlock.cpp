@@ -36,22 +36,25 @@ BaseBlock::~BaseBlock()
     // If this triggers then there is a bug in our zone cleanup loop that needs to be addressed
     AXASSERT(_sprites.empty(), "Sprites were not recycled properly!");
     AXASSERT(_accessories.empty(), "Accessories were not recycled properly!");
+    AXASSERT(_bakedRenderers.empty(), "Baked sprites were not recycled properly!");
     AX_SAFE_RELEASE(_miningAction);
     sBlocksAllocated--;
 }
 
-BaseBlock* BaseBlock::createWithZone(WorldZone* zone, int16_t x, int16_t y)
+BaseBlock* BaseBlock::createWithChunk(WorldChunk* chunk, uint32_t slot)
 {
-    CREATE_INIT(BaseBlock, initWithZone, zone, x, y);
+    CREATE_INIT(BaseBlock, initWithChunk, chunk, slot);
 }
 
-bool BaseBlock::initWithZone(WorldZone* zone, int16_t x, int16_t y)
+bool BaseBlock::initWithChunk(WorldChunk* chunk, uint32_t slot)
 {
+    auto zone     = chunk->getZone();
     _zone         = zone;
-    _x            = x;
-    _y            = y;
-    _placing      = true;
-    _rendering    = false;
+    _chunk        = chunk;
+    _slot         = slot;
+    _localX       = slot % zone->getChunkWidth();
+    _localY       = slot / zone->getChunkWidth();
+    _queuedAt     = 0.0;
     _physical     = nullptr;
     _miningAction = nullptr;
     sBlocksAllocated++;
@@ -60,24 +63,25 @@ bool BaseBlock::initWithZone(WorldZone* zone, int16_t x, int16_t y)
 
 std::string BaseBlock::getDescription() const
 {
-    return std::format("<Block {}x{}: Base {}:{}, Back {}:{}:{}, Front {}:{}:{}:{}, Liquid {}:{}:{}>", _x, _y, _base,
-                       _baseItem->getName(), _back, _backItem->getName(), _backMod, _front, _frontItem->getName(),
-                       _frontMod, _frontNatural ? "natural" : "user", _liquid, _liquidItem->getName(), _liquidMod);
+    return std::format("<Block {}x{}: Base {}:{}, Back {}:{}:{}, Front {}:{}:{}:{}, Liquid {}:{}:{}>", getX(), getY(),
+                       getBase(), getBaseItem()->getName(), getBack(), getBackItem()->getName(), getBackMod(),
+                       getFront(), getFrontItem()->getName(), getFrontMod(), isFrontNatural() ? "natural" : "user",
+                       getLiquid(), getLiquidItem()->getName(), getLiquidMod());
 }
 
-void BaseBlock::setData(const ValueVector& data, uint32_t index)
+void BaseBlock::setData(const uint32_t* data, uint32_t index)
 {
-    auto base     = data[(size_t)index * 3].asUint();
-    auto back     = data[(size_t)index * 3 + 1].asUint();
-    auto front    = data[(size_t)index * 3 + 2].asUint();
-    _base         = base & 0xF;
-    _liquid       = (base >> 8) & 0xFF;
-    _liquidMod    = (base >> 16) & 0x1F;
-    _back         = back & 0xFFFF;
-    _backMod      = (back >> 16) & 0x1F;
-    _front        = front & 0xFFFF;
-    _frontMod     = (front >> 16) & 0x1F;
-    _frontNatural = front < 0x100000;
+    auto base                     = data[(size_t)index * 3];
+    auto back                     = data[(size_t)index * 3 + 1];
+    auto front                    = data[(size_t)index * 3 + 2];
+    _chunk->_bases[_slot]         = base & 0xF;
+    _chunk->_liquids[_slot]       = (base >> 8) & 0xFF;
+    _chunk->_liquidMods[_slot]    = (base >> 16) & 0x1F;
+    _chunk->_backs[_slot]         = back & 0xFFFF;
+    _chunk->_backMods[_slot]      = (back >> 16) & 0x1F;
+    _chunk->_fronts[_slot]        = front & 0xFFFF;
+    _chunk->_frontMods[_slot]     = (front >> 16) & 0x1F;
+    _chunk->_frontNaturals[_slot] = front < 0x100000;
 
     // 0x10002E853: This check is not necessary because opendw has a much higher item limit
     /*if (_front >= 2000)
@@ -85,19 +89,40 @@ void BaseBlock::setData(const ValueVector& data, uint32_t index)
         AXLOGW("SUPER BAD WARNING: invalid item code {} detected at block front {} {}", _front, _x, _y);
     }*/
 
-    auto config = GameManager::getInstance()->getConfig();
-    _baseItem   = config->getItemForCode(_base);
-    _liquidItem = config->getItemForCode(_liquid);
+    auto config                 = GameManager::getInstance()->getConfig();
+    _chunk->_baseItems[_slot]   = config->getItemForCode(getBase());
+    _chunk->_liquidItems[_slot] = config->getItemForCode(getLiquid());
     updateBack();
     updateFront();
     // TODO: updateIllumination(false);
 }
 
+bool BaseBlock::hasData(const uint32_t* data, uint32_t index) const
+{
+    // Blocks without a front item have never received any data
+    if (!getFrontItem())
+    {
+        return false;
+    }
+
+    // Compare against the decoded layers rather than what was last received, because local changes such as mining
+    // predictions only update the layers and must be undone when the server resends its own data
+    auto base  = data[(size_t)index * 3];
+    auto back  = data[(size_t)index * 3 + 1];
+    auto front = data[(size_t)index * 3 + 2];
+    return getBase() == (base & 0xF) && getLiquid() == ((base >> 8) & 0xFF) &&
+           getLiquidMod() == ((base >> 16) & 0x1F) && getBack() == (back & 0xFFFF) &&
+           getBackMod() == ((back >> 16) & 0x1F) && getFront() == (front & 0xFFFF) &&
+           getFrontMod() == ((front >> 16) & 0x1F) && isFrontNatural() == (front < 0x100000);
+}
+
 void BaseBlock::postPlace()
 {
-    updateEnvironment();
+    // Wholeness and continuity are already up to date if the chunk recomputed its environment in bulk
+    auto recompute = !_chunk->isEnvironmentValid();
+    updateEnvironment(true, true, recompute, recompute);
     updatePhysical();  // NOTE: adminLoad seems to be practically unused
-    _placing = false;
+    setPlacing(false);
 }
 
 void BaseBlock::updateEnvironment(bool light, bool liquid, bool wholeness, bool continuity)
@@ -111,93 +136,144 @@ void BaseBlock::updateEnvironment(bool light, bool liquid, bool wholeness, bool
     {
         BaseBlock* neighbors[8];  // Stack allocation; no need to delete
         getNeighbors(neighbors);
+        Layers neighborLayers[8];
+        const Layers* neighborPointers[8];
 
-        // 0x10002F96C: Update wholeness
-        if (wholeness)
+        for (uint8_t i = 0; i < 8; i++)
         {
-            _wholeness = 0;
+            auto block          = neighbors[i];
+            neighborPointers[i] = nullptr;
 
-            for (uint8_t i = 0; i < 8; i++)
+            if (block)
             {
-                auto block = neighbors[i];
-                _wholeness |= (!block || block->getFrontItem()->isWhole()) << i;
+                neighborLayers[i]   = block->getLayers();
+                neighborPointers[i] = &neighborLayers[i];
             }
         }
 
-        // 0x10002FB7D: Update continuity
+        Environment environment;
+        computeEnvironment(getLayers(), neighborPointers, wholeness, continuity, environment);
+
+        if (wholeness)
+        {
+            _chunk->_wholeness[_slot] = environment.wholeness;
+        }
+
         if (continuity)
         {
-            _baseContinuity     = 0;
-            _backContinuity     = 0;
-            _backModContinuity  = 0;
-            _frontContinuity    = 0;
-            _frontModContinuity = 0;
+            _chunk->_baseContinuity[_slot]     = environment.baseContinuity;
+            _chunk->_backContinuity[_slot]     = environment.backContinuity;
+            _chunk->_backModContinuity[_slot]  = environment.backModContinuity;
+            _chunk->_frontContinuity[_slot]    = environment.frontContinuity;
+            _chunk->_frontModContinuity[_slot] = environment.frontModContinuity;
+        }
+    }
 
-            for (uint8_t i = 0; i < 8; i++)
-            {
-                auto block = neighbors[i];
+    // 0x100030557: Queue block for rendering if necessary
+    // TODO: it specifically checks for `placing != 1` (placing is set to 2 on chunk recycle)
+    if (!isRendering() && !isPlacing())
+    {
+        _zone->getWorldRenderer()->queueBlockForRendering(this);
+    }
+}
 
-                // Corner blocks do not affect base continuity
-                if (i < 4)
-                {
-                    _baseContinuity |= (!block || block->getBaseItem()->isContinuousFor(_baseItem)) << i;
-                }
+void BaseBlock::computeEnvironment(const Layers& layers,
+                                   const Layers* const neighbors[8],
+                                   bool wholeness,
+                                   bool continuity,
+                                   Environment& environment)
+{
+    // 0x10002F96C: Update wholeness
+    if (wholeness)
+    {
+        environment.wholeness = 0;
+
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            auto block = neighbors[i];
+            environment.wholeness |= (!block || block->frontItem->isWhole()) << i;
+        }
+    }
+
+    // 0x10002FB7D: Update continuity
+    if (continuity)
+    {
+        auto baseItem              = layers.baseItem;
+        auto backItem              = layers.backItem;
+        auto frontItem             = layers.frontItem;
+        auto front                 = frontItem->getCode();
+        uint8_t baseContinuity     = 0;
+        uint8_t backContinuity     = 0;
+        uint8_t backModContinuity  = 0;
+        uint8_t frontContinuity    = 0;
+        uint8_t frontModContinuity = 0;
+
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            auto block = neighbors[i];
 
-                _backContinuity |= (!block || block->getBackItem()->isContinuousFor(_backItem)) << i;
-                _backModContinuity |= (block && block->getBackMod() > 0) << i;
-                _frontContinuity |= (!block || block->getFrontItem()->isContinuousFor(_frontItem)) << i;
-                _frontModContinuity |= (block && block->getFrontMod() > 0) << i;
+            // Corner blocks do not affect base continuity
+            if (i < 4)
+            {
+                baseContinuity |= (!block || block->baseItem->isContinuousFor(baseItem)) << i;
+            }
+
+            backContinuity |= (!block || block->backItem->isContinuousFor(backItem)) << i;
+            backModContinuity |= (block && block->backMod > 0) << i;
+            frontContinuity |= (!block || block->frontItem->isContinuousFor(frontItem)) << i;
+            frontModContinuity |= (block && block->frontMod > 0) << i;
 
 #if SPECIAL_PIPE_CONTINUITY
-                if (i == 1 && _front == item_codes::MECHANICAL_PIPE && block &&
-                    block->getRealFrontItem()->isSteamPowered())
+            if (i == 1 && front == item_codes::MECHANICAL_PIPE && block)
+            {
+                auto parent = block->frontItem->getParentItem();
+
+                if ((parent ? parent : block->frontItem)->isSteamPowered())
                 {
-                    _frontContinuity |= CONTINUITY_RIGHT;
+                    frontContinuity |= CONTINUITY_RIGHT;
                 }
-#endif  // SPECIAL_PIPE_CONTINUITY
             }
+#endif  // SPECIAL_PIPE_CONTINUITY
+        }
 
-            // 0x10003046A: Handle special front continuity
+        // 0x10003046A: Handle special front continuity
 #if SPECIAL_FRONT_CONTINUITY
-            if (_front == item_codes::GLASS || _front == item_codes::BALLOON || _front == item_codes::BALLOON_STRIPED)
+        if (front == item_codes::GLASS || front == item_codes::BALLOON || front == item_codes::BALLOON_STRIPED)
+        {
+            // Unset top continuity if front is continuous with its right neighbor but not with its top right
+            // neighbor OR if it is continuous with its left neighbor but not with its top left neighbor
+            if ((frontContinuity & (CONTINUITY_RIGHT | CONTINUITY_TOP_RIGHT)) == CONTINUITY_RIGHT ||
+                (frontContinuity & (CONTINUITY_LEFT | CONTINUITY_TOP_LEFT)) == CONTINUITY_LEFT)
             {
-                // Unset top continuity if front is continuous with its right neighbor but not with its top right
-                // neighbor OR if it is continuous with its left neighbor but not with its top left neighbor
-                if ((_frontContinuity & (CONTINUITY_RIGHT | CONTINUITY_TOP_RIGHT)) == CONTINUITY_RIGHT ||
-                    (_frontContinuity & (CONTINUITY_LEFT | CONTINUITY_TOP_LEFT)) == CONTINUITY_LEFT)
-                {
-                    _frontContinuity &= ~CONTINUITY_TOP;
-                }
+                frontContinuity &= ~CONTINUITY_TOP;
+            }
 
-                // Unset bottom continuity if front is continuous with its right neighbor but not with its bottom right
-                // neighbor OR if it is continuous with its left neighbor but not with its bottom left neighbor
-                if ((_frontContinuity & (CONTINUITY_RIGHT | CONTINUITY_BOTTOM_RIGHT)) == CONTINUITY_RIGHT ||
-                    (_frontContinuity & (CONTINUITY_LEFT | CONTINUITY_BOTTOM_LEFT)) == CONTINUITY_LEFT)
-                {
-                    _frontContinuity &= ~CONTINUITY_BOTTOM;
-                }
+            // Unset bottom continuity if front is continuous with its right neighbor but not with its bottom right
+            // neighbor OR if it is continuous with its left neighbor but not with its bottom left neighbor
+            if ((frontContinuity & (CONTINUITY_RIGHT | CONTINUITY_BOTTOM_RIGHT)) == CONTINUITY_RIGHT ||
+                (frontContinuity & (CONTINUITY_LEFT | CONTINUITY_BOTTOM_LEFT)) == CONTINUITY_LEFT)
+            {
+                frontContinuity &= ~CONTINUITY_BOTTOM;
+            }
 
-                // Reset continuity if front is continuous with only its top OR bottom neighbor and one or both of its
-                // respective corners
-                auto edgeContinuity = _frontContinuity & CONTINUITY_EDGES;
+            // Reset continuity if front is continuous with only its top OR bottom neighbor and one or both of its
+            // respective corners
+            auto edgeContinuity = frontContinuity & CONTINUITY_EDGES;
 
-                if ((edgeContinuity == CONTINUITY_TOP &&
-                     _frontContinuity & (CONTINUITY_TOP_RIGHT | CONTINUITY_TOP_LEFT)) ||
-                    (edgeContinuity == CONTINUITY_BOTTOM &&
-                     _frontContinuity & (CONTINUITY_BOTTOM_RIGHT | CONTINUITY_BOTTOM_LEFT)))
-                {
-                    _frontContinuity = 0;
-                }
+            if ((edgeContinuity == CONTINUITY_TOP && frontContinuity & (CONTINUITY_TOP_RIGHT | CONTINUITY_TOP_LEFT)) ||
+                (edgeContinuity == CONTINUITY_BOTTOM &&
+                 frontContinuity & (CONTINUITY_BOTTOM_RIGHT | CONTINUITY_BOTTOM_LEFT)))
+            {
+                frontContinuity = 0;
             }
-#endif  // SPECIAL_FRONT_CONTINUITY
         }
-    }
+#endif  // SPECIAL_FRONT_CONTINUITY
 
-    // 0x100030557: Queue block for rendering if necessary
-    // TODO: it specifically checks for `placing != 1` (placing is set to 2 on chunk recycle)
-    if (!_rendering && !_placing)
-    {
-        _zone->getWorldRenderer()->queueBlockForRendering(this);
+        environment.baseContinuity     = baseContinuity;
+        environment.backContinuity     = backContinuity;
+        environment.backModContinuity  = backModContinuity;
+        environment.frontContinuity    = frontContinuity;
+        environment.frontModContinuity = frontModContinuity;
     }
 }
 
@@ -223,19 +299,19 @@ void BaseBlock::setLayer(BlockLayer layer, uint16_t item, uint8_t mod)
         setBase(item);
         break;
     case BlockLayer::BACK:
-        if (_back != item || _backMod != mod)
+        if (getBack() != item || getBackMod() != mod)
         {
-            _back    = item;
-            _backMod = mod;
+            _chunk->_backs[_slot]    = item;
+            _chunk->_backMods[_slot] = mod;
             updateBack();
         }
 
         break;
     case BlockLayer::FRONT:
-        if (_front != item || _frontMod != mod)
+        if (getFront() != item || getFrontMod() != mod)
         {
-            _front    = item;
-            _frontMod = mod;
+            _chunk->_fronts[_slot]    = item;
+            _chunk->_frontMods[_slot] = mod;
             updateFront();
         }
 
@@ -243,14 +319,16 @@ void BaseBlock::setLayer(BlockLayer layer, uint16_t item, uint8_t mod)
     case BlockLayer::LIQUID:
         mod = MIN(5, mod);
 
-        if (_liquid != item || _liquidMod != mod)
+        if (getLiquid() != item || getLiquidMod() != mod)
         {
-            _liquid     = item;
-            _liquidMod  = mod;
-            _liquidItem = GameManager::getInstance()->getConfig()->getItemForCode(_liquid);
+            _chunk->_liquids[_slot]     = item;
+            _chunk->_liquidMods[_slot]  = mod;
+            _chunk->_liquidItems[_slot] = GameManager::getInstance()->getConfig()->getItemForCode(getLiquid());
+            _chunk->updateEffectIndex(_slot);
+            _chunk->invalidateLight(_slot);
             // TODO: updateIllumination(true);
 
-            if (!_placing)
+            if (!isPlacing())
             {
                 updateLiquid(true);
             }
@@ -284,13 +362,13 @@ Item* BaseBlock::getItemForLayer(BlockLayer layer) const
     switch (layer)
     {
     case BlockLayer::BASE:
-        return _baseItem;
+        return getBaseItem();
     case BlockLayer::BACK:
-        return _backItem;
+        return getBackItem();
     case BlockLayer::FRONT:
-        return _frontItem;
+        return getFrontItem();
     case BlockLayer::LIQUID:
-        return _liquidItem;
+        return getLiquidItem();
     default:
         return nullptr;
     }
@@ -317,11 +395,11 @@ uint8_t BaseBlock::getModForLayer(BlockLayer layer) const
     switch (layer)
     {
     case BlockLayer::BACK:
-        return _backMod;
+        return getBackMod();
     case BlockLayer::FRONT:
-        return _frontMod;
+        return getFrontMod();
     case BlockLayer::LIQUID:
-        return _liquidMod;
+        return getLiquidMod();
     default:
         return 0;
     }
@@ -332,29 +410,36 @@ uint8_t BaseBlock::getContinuityForLayer(BlockLayer layer) const
     switch (layer)
     {
     case BlockLayer::BASE:
-        return _baseContinuity;
+        return _chunk->_baseContinuity[_slot];
     case BlockLayer::BACK:
-        return _backContinuity;
+        return _chunk->_backContinuity[_slot];
     case BlockLayer::FRONT:
-        return _frontContinuity;
+        return _chunk->_frontContinuity[_slot];
     default:
         return 0;
     }
 }
 
+BaseBlock::Layers BaseBlock::getLayers() const
+{
+    return {getBaseItem(), getBackItem(), getFrontItem(), getBackMod(), getFrontMod()};
+}
+
 Point BaseBlock::getWorldPosition() const
 {
-    return _zone->getPointAtBlock(_x, _y);
+    return _zone->getPointAtBlock(getX(), getY());
 }
 
 void BaseBlock::setBase(uint8_t base)
 {
-    if (_base != base)
+    if (getBase() != base)
     {
-        _base     = base;
-        _baseItem = GameManager::getInstance()->getConfig()->getItemForCode(_base);
+        _chunk->_bases[_slot]     = base;
+        _chunk->_baseItems[_slot] = GameManager::getInstance()->getConfig()->getItemForCode(getBase());
+        _chunk->updateEffectIndex(_slot);
+        _chunk->invalidateLight(_slot);
 
-        if (!_placing)
+        if (!isPlacing())
         {
             updateEnvironment();
             updateNeighbors();
@@ -364,48 +449,50 @@ void BaseBlock::setBase(uint8_t base)
 
 void BaseBlock::setBack(uint16_t back)
 {
-    if (_back != back)
+    if (getBack() != back)
     {
-        _back = back;
+        _chunk->_backs[_slot] = back;
         updateBack();
     }
 }
 
 void BaseBlock::setBackMod(uint8_t backMod)
 {
-    if (_backMod != backMod)
+    if (getBackMod() != backMod)
     {
-        _backMod = backMod;
+        _chunk->_backMods[_slot] = backMod;
         updateBack();
     }
 }
 
 void BaseBlock::setFront(uint16_t front)
 {
-    if (_front != front)
+    if (getFront() != front)
     {
-        _front = front;
+        _chunk->_fronts[_slot] = front;
         updateFront();
     }
 }
 
 void BaseBlock::setFrontMod(uint8_t frontMod)
 {
-    if (_frontMod != frontMod)
+    if (getFrontMod() != frontMod)
     {
-        _frontMod = frontMod;
+        _chunk->_frontMods[_slot] = frontMod;
         updateFront();
     }
 }
 
 void BaseBlock::setLiquid(uint8_t liquid)
 {
-    if (_liquid != liquid)
+    if (getLiquid() != liquid)
     {
-        _liquidItem = GameManager::getInstance()->getConfig()->getItemForCode(liquid);
+        _chunk->_liquidItems[_slot] = GameManager::getInstance()->getConfig()->getItemForCode(liquid);
+        _chunk->updateEffectIndex(_slot);
+        _chunk->invalidateLight(_slot);
         // TODO: updateIllumination(true);
 
-        if (!_placing)
+        if (!isPlacing())
         {
             updateLiquid(true);
         }
@@ -416,11 +503,11 @@ void BaseBlock::setLiquidMod(uint8_t liquidMod)
 {
     liquidMod = MIN(5, liquidMod);
 
-    if (_liquidMod != liquidMod)
+    if (getLiquidMod() != liquidMod)
     {
-        _liquidMod = liquidMod;
+        _chunk->_liquidMods[_slot] = liquidMod;
 
-        if (!_placing)
+        if (!isPlacing())
         {
             updateLiquid(true);
         }
@@ -429,9 +516,9 @@ void BaseBlock::setLiquidMod(uint8_t liquidMod)
 
 void BaseBlock::updateLiquid(bool updateNeighbors)
 {
-    _liquidity = 0;
+    uint16_t liquidity = 0;
 
-    if (_liquid > 0)
+    if (getLiquid() > 0)
     {
         // 0x1000305E0: Check volume of surrounding liquid blocks
         auto above = getAbove();
@@ -446,7 +533,7 @@ void BaseBlock::updateLiquid(bool updateNeighbors)
 
             if (block && block->getLiquid() > 0)
             {
-                _liquidity |= (block->getLiquidMod() & 0xF) << (i * 4);
+                liquidity |= (block->getLiquidMod() & 0xF) << (i * 4);
             }
         }
 
@@ -479,6 +566,8 @@ void BaseBlock::updateLiquid(bool updateNeighbors)
         }
     }
 
+    _chunk->_liquidity[_slot] = liquidity;
+
     // It's faster to just render it directly rather than redrawing the entire block.
     // Liquid doesn't really interact with/affect any other layers anyway.
     _zone->getWorldRenderer()->updateLiquidInBlock(this);
@@ -487,11 +576,11 @@ void BaseBlock::updateLiquid(bool updateNeighbors)
 void BaseBlock::updateFront()
 {
     auto config = GameManager::getInstance()->getConfig();
-    auto item   = config->getItemForCode(_front);
+    auto item   = config->getItemForCode(getFront());
     AX_ASSERT(item);
 
     // 0x10002EFA8: Update change item
-    if (item->getUseChangeItem() && _frontMod > 0)
+    if (item->getUseChangeItem() && getFrontMod() > 0)
     {
         item = item->getUseChangeItem();
     }
@@ -504,22 +593,24 @@ void BaseBlock::updateFront()
             item = parent;
         }
 
-        if (_frontMod > 0)
+        if (getFrontMod() > 0)
         {
             auto& changeItems = item->getChangeItems();
 
-            if (_frontMod <= changeItems.size())
+            if (getFrontMod() <= changeItems.size())
             {
-                item = changeItems[_frontMod - 1];  // Safe
+                item = changeItems[getFrontMod() - 1];  // Safe
                 AX_ASSERT(item);
             }
         }
     }
 
-    _front     = item->getCode();
-    _frontItem = item;
+    _chunk->_fronts[_slot]     = item->getCode();
+    _chunk->_frontItems[_slot] = item;
+    _chunk->updateEffectIndex(_slot);
+    _chunk->invalidateLight(_slot);
 
-    if (!_placing)
+    if (!isPlacing())
     {
         updateEnvironment();
         updateNeighbors();
@@ -537,11 +628,11 @@ void BaseBlock::updateFront()
 void BaseBlock::updateBack()
 {
     auto config = GameManager::getInstance()->getConfig();
-    auto item   = config->getItemForCode(_back);
+    auto item   = config->getItemForCode(getBack());
     AX_ASSERT(item);
 
     // 0x10002F2DC: Update change item
-    if (item->getUseChangeItem() && _backMod > 0)
+    if (item->getUseChangeItem() && getBackMod() > 0)
     {
         item = item->getUseChangeItem();
     }
@@ -554,22 +645,24 @@ void BaseBlock::updateBack()
             item = parent;
         }
 
-        if (_backMod > 0)
+        if (getBackMod() > 0)
         {
             auto& changeItems = item->getChangeItems();
 
-            if (_backMod <= changeItems.size())
+            if (getBackMod() <= changeItems.size())
             {
-                item = changeItems[_backMod - 1];  // Safe
+                item = changeItems[getBackMod() - 1];  // Safe
                 AX_ASSERT(item);
             }
         }
     }
 
-    _back     = item->getCode();
-    _backItem = item;
+    _chunk->_backs[_slot]     = item->getCode();
+    _chunk->_backItems[_slot] = item;
+    _chunk->updateEffectIndex(_slot);
+    _chunk->invalidateLight(_slot);
 
-    if (!_placing)
+    if (!isPlacing())
     {
         updateEnvironment();
         updateNeighbors();
@@ -584,6 +677,8 @@ void BaseBlock::clearFromWorld()
 
 void BaseBlock::clearPhysical()
 {
+    _chunk->setColliding(_slot, false);
+
     if (_physical)
     {
         _zone->getSpace()->remove(_physical);
@@ -598,7 +693,7 @@ void BaseBlock::updatePhysical()
 
 void BaseBlock::processPhysical()
 {
-    auto shape = _frontItem->getShape();
+    auto shape = getFrontItem()->getShape();
     auto space = _zone->getSpace();
 
     if (shape == Item::Shape::NONE)
@@ -607,6 +702,22 @@ void BaseBlock::processPhysical()
         return;
     }
 
+    // Whole box-shaped blocks are merged into the collider of the chunk instead of getting a body of their own
+    if (shape == Item::Shape::BOX &&
+        (getFrontItem()->isTileable() || (getFrontItem()->getWidth() <= 1 && getFrontItem()->getHeight() <= 1)))
+    {
+        if (_physical)
+        {
+            space->remove(_physical);
+            AX_SAFE_RELEASE_NULL(_physical);
+        }
+
+        _chunk->setColliding(_slot, true);
+        return;
+    }
+
+    _chunk->setColliding(_slot, false);
+
     if (_physical)
     {
         space->remove(_physical);
@@ -622,10 +733,10 @@ void BaseBlock::processPhysical()
     auto position  = getWorldPosition() - blockSize * 0.5F;
     auto size      = blockSize;
 
-    if (!_frontItem->isTileable())
+    if (!getFrontItem()->isTileable())
     {
-        size.width *= _frontItem->getWidth();
-        size.height *= _frontItem->getHeight();
+        size.width *= getFrontItem()->getWidth();
+        size.height *= getFrontItem()->getHeight();
     }
 
     switch (shape)
@@ -638,17 +749,18 @@ void BaseBlock::processPhysical()
     }
     case Item::Shape::POLYGONAL:
     {
-        auto& definition = GameConfig::getMain()->getPhysicsDefinitionForItem(_frontItem->getShapeDefinition());
+        auto& definition = GameConfig::getMain()->getPhysicsDefinitionForItem(getFrontItem()->getShapeDefinition());
 
         if (definition.empty())
         {
-            AXLOGW("WARNING: Item {} has polygonal shape but no def", _frontItem->getName());
+            AXLOGW("WARNING: Item {} has polygonal shape but no def", getFrontItem()->getName());
             AX_SAFE_RELEASE_NULL(_physical);
             return;
         }
 
-        auto flipped  = _frontItem->isMirrorable() && _frontMod == 4;
-        auto rotation = _frontItem->getModType() == ModType::ROTATION && !flipped ? (_frontMod % 4) * 90.0F : 0.0F;
+        auto frontMod = getFrontMod();
+        auto flipped  = getFrontItem()->isMirrorable() && frontMod == 4;
+        auto rotation = getFrontItem()->getModType() == ModType::ROTATION && !flipped ? (frontMod % 4) * 90.0F : 0.0F;
         _physical->setShapeFromDefinition(definition, size, position, rotation, flipped);
         break;
     }
@@ -662,12 +774,12 @@ void BaseBlock::processPhysical()
 
 BlockLayer BaseBlock::getTopUsableLayer() const
 {
-    if (_front > 0 && _frontItem->isUsable())
+    if (getFront() > 0 && getFrontItem()->isUsable())
     {
         return BlockLayer::FRONT;
     }
 
-    if (_back > 0 && _backItem->isUsable())
+    if (getBack() > 0 && getBackItem()->isUsable())
     {
         return BlockLayer::BACK;
     }
@@ -687,7 +799,7 @@ void BaseBlock::useLayer(BlockLayer layer, bool sendMessage)
     // 0x100031020: Check permission
     if (item->isUsableType(UseType::PROTECTED))
     {
-        auto metaBlock = _zone->getMetaBlockAt(_x, _y);
+        auto metaBlock = _zone->getMetaBlockAt(getX(), getY());
 
         if (metaBlock && !metaBlock->isOwnedByPlayer())
         {
@@ -753,7 +865,8 @@ void BaseBlock::useLayer(BlockLayer layer, bool sendMessage)
 
 void BaseBlock::sendUseMessageForLayer(BlockLayer layer, const Value& data)
 {
-    GameManager::getInstance()->sendMessage(MessageIdent::BLOCK_USE, _x, _y, static_cast<uint8_t>(layer) - 1, data);
+    GameManager::getInstance()->sendMessage(MessageIdent::BLOCK_USE, getX(), getY(), static_cast<uint8_t>(layer) - 1,
+                                            data);
 }
 
 void BaseBlock::startMining(BlockLayer layer, Item* tool)
@@ -786,6 +899,9 @@ void BaseBlock::startMining(BlockLayer layer, Item* tool)
         duration = clampf(duration, 0.4F, 999.0F);
     }
 
+    // The mining animation needs a live sprite to act on
+    WorldRenderer::getMain()->unbakeBlock(this);
+
     if (auto sprite = getMainSpriteForLayer(layer))
     {
         if (item->isOpaque() || item->isWhole())
@@ -828,7 +944,7 @@ void BaseBlock::completeMining(BlockLayer layer)
     auto item = getItemForLayer(layer);
     auto mod  = getModForLayer(layer);
     auto code = item->getParentItem() ? item->getParentItem()->getCode() : item->getCode();
-    game->sendMessage(MessageIdent::BLOCK_MINE, _x, _y, static_cast<uint8_t>(layer) - 1, code, mod);
+    game->sendMessage(MessageIdent::BLOCK_MINE, getX(), getY(), static_cast<uint8_t>(layer) - 1, code, mod);
 
     if (tool && tool->getAction() == Item::Action::DIG && item->isDiggable())
     {
@@ -906,6 +1022,22 @@ void BaseBlock::recycleSprites(BlockLayer layer)
         }
     }
 
+    // Remove baked quads
+    for (auto it = _bakedRenderers.begin(); it != _bakedRenderers.end();)
+    {
+        auto renderer = *it;
+
+        if (layer == BlockLayer::NONE || renderer->getLayer() == layer)
+        {
+            renderer->removeBakedQuads(this);
+            it = _bakedRenderers.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+
     // Clear accessories
     for (auto it = _accessories.begin(); it != _accessories.end();)
     {
@@ -925,6 +1057,43 @@ void BaseBlock::recycleSprites(BlockLayer layer)
     }
 }
 
+void BaseBlock::bakeSprites()
+{
+    // Sprites in the baked z range of a renderer are only baked if all of them can be. Their order is then decided
+    // entirely by the mesh, instead of some of them being drawn below the rest in the batch node.
+    std::vector<WorldLayerRenderer*> liveRenderers;
+
+    for (auto sprite : _sprites)
+    {
+        auto renderer = static_cast<WorldLayerRenderer*>(sprite->getUserData());
+
+        if (sprite->getLocalZOrder() <= WorldLayerRenderer::MESH_MAX_Z && !renderer->canBakeSprite(this, sprite))
+        {
+            liveRenderers.push_back(renderer);
+        }
+    }
+
+    for (auto it = _sprites.begin(); it != _sprites.end();)
+    {
+        auto sprite   = *it;
+        auto renderer = static_cast<WorldLayerRenderer*>(sprite->getUserData());
+
+        if (std::find(liveRenderers.begin(), liveRenderers.end(), renderer) != liveRenderers.end() ||
+            !renderer->bakeSprite(this, sprite))
+        {
+            it++;
+            continue;
+        }
+
+        if (std::find(_bakedRenderers.begin(), _bakedRenderers.end(), renderer) == _bakedRenderers.end())
+        {
+            _bakedRenderers.push_back(renderer);
+        }
+
+        it = _sprites.erase(it);
+    }
+}
+
 void BaseBlock::recycleSpriteWithTag(int tag)
 {
     // Removing while iterating should be slightly faster than using getSpriteWithTag
@@ -1012,11 +1181,11 @@ bool BaseBlock::canPlace(Item* item) const
     auto layer = item->getLayer();
 
     // 0x100030E25: Check front occupation
-    if (_front > 0)
+    if (getFront() > 0)
     {
-        if (!_frontItem->canPlaceover())
+        if (!getFrontItem()->canPlaceover())
         {
-            if (layer == BlockLayer::FRONT || _frontItem->isWhole())
+            if (layer == BlockLayer::FRONT || getFrontItem()->isWhole())
             {
                 return false;
             }
@@ -1024,13 +1193,13 @@ bool BaseBlock::canPlace(Item* item) const
     }
 
     // 0x100030E5B: Check for wall if item is wall mounted
-    if (item->isMounted() && _back == 0 && _base < 2)
+    if (item->isMounted() && getBack() == 0 && getBase() < 2)
     {
         return false;
     }
 
     // 0x100030E8D: Check back occupation
-    if (layer == BlockLayer::BACK && _back > 0 && !_backItem->canPlaceover())
+    if (layer == BlockLayer::BACK && getBack() > 0 && !getBackItem()->canPlaceover())
     {
         return false;
     }
@@ -1041,11 +1210,12 @@ bool BaseBlock::canPlace(Item* item) const
 bool BaseBlock::isProtectedByField() const
 {
     // TODO: awesome mode, validations, karma level
-    auto item      = _front > 0 ? _frontItem : _backItem;
+    auto item      = getFront() > 0 ? getFrontItem() : getBackItem();
     auto fieldable = item->getFieldable();
 
     // Check fieldability
-    if (fieldable == Item::Fieldable::NO || (_front > 0 && fieldable == Item::Fieldable::PLACED && _frontNatural))
+    if (fieldable == Item::Fieldable::NO ||
+        (getFront() > 0 && fieldable == Item::Fieldable::PLACED && isFrontNatural()))
     {
         return false;
     }
@@ -1059,7 +1229,7 @@ bool BaseBlock::isProtectedByField() const
     // Check self protection
     if (item->getField() > 0)
     {
-        auto metaBlock = _zone->getMetaBlockAt(_x, _y);
+        auto metaBlock = _zone->getMetaBlockAt(getX(), getY());
 
         if (!metaBlock || !metaBlock->isOwnedByPlayer())
         {
@@ -1068,16 +1238,14 @@ bool BaseBlock::isProtectedByField() const
     }
 
     // Check field protection
-    for (auto& entry : _zone->getFieldMetaBlocks())
+    for (auto metaBlock : _zone->getFieldGrid().getFieldsAt(getX(), getY()))
     {
-        auto metaBlock  = entry.second;
-
         if (metaBlock->getItem()->getField() > 1)
         {
             auto permission = metaBlock->isOwnedByPlayer() || (map_util::getInt32(metaBlock->getMetadata(), "t") == 1 &&
                                                                metaBlock->isOwnedByPlayerOrFollower());
 
-            if (!permission && math_util::getDistance(_x, _y, metaBlock->getX(), metaBlock->getY()) <=
+            if (!permission && math_util::getDistance(getX(), getY(), metaBlock->getX(), metaBlock->getY()) <=
                                    metaBlock->getItem()->getField())
             {
                 return true;
@@ -1097,8 +1265,8 @@ bool BaseBlock::isReachableFrom(BlockLayer layer, int16_t x, int16_t y, bool all
         return false;
     }
 
-    auto distanceX = x - _x;
-    auto distanceY = _y - y;
+    auto distanceX = x - getX();
+    auto distanceY = getY() - y;
     return distanceX >= 0 && distanceX < item->getWidth() && distanceY >= 0 && distanceY < item->getHeight();
 }
 
@@ -1122,56 +1290,56 @@ bool BaseBlock::isOpaque(BlockLayer layer) const
 
 bool BaseBlock::isBackOpaque() const
 {
-    return _backItem->isOpaque() && (_backItem->getModType() != ModType::DECAY || _backMod < 2);
+    return getBackItem()->isOpaque() && (getBackItem()->getModType() != ModType::DECAY || getBackMod() < 2);
 }
 
 bool BaseBlock::isFrontOpaque() const
 {
-    return _frontItem->isOpaque() && (_frontItem->getModType() != ModType::DECAY || _frontMod < 2);
+    return getFrontItem()->isOpaque() && (getFrontItem()->getModType() != ModType::DECAY || getFrontMod() < 2);
 }
 
 BaseBlock* BaseBlock::getAbove() const
 {
-    return _zone->getBlockAt(_x, _y - 1);
+    return _zone->getBlockAt(getX(), getY() - 1);
 }
 
 BaseBlock* BaseBlock::getBelow() const
 {
-    return _zone->getBlockAt(_x, _y + 1);
+    return _zone->getBlockAt(getX(), getY() + 1);
 }
 
 BaseBlock* BaseBlock::getLeft() const
 {
-    return _zone->getBlockAt(_x - 1, _y);
+    return _zone->getBlockAt(getX() - 1, getY());
 }
 
 BaseBlock* BaseBlock::getRight() const
 {
-    return _zone->getBlockAt(_x + 1, _y);
+    return _zone->getBlockAt(getX() + 1, getY());
 }
 
 bool BaseBlock::isWhole() const
 {
-    return _frontItem->isWhole();
+    return getFrontItem()->isWhole();
 }
 
 Item* BaseBlock::getRealFrontItem() const
 {
-    auto parent = _frontItem->getParentItem();
-    return parent ? parent : _frontItem;
+    auto parent = getFrontItem()->getParentItem();
+    return parent ? parent : getFrontItem();
 }
 
 void BaseBlock::getNeighbors(BaseBlock* neighbors[8]) const
 {
     // We're just going to assume that there's enough room for 8
-    neighbors[0] = _zone->getBlockAt(_x, _y - 1);      // Top
-    neighbors[1] = _zone->getBlockAt(_x + 1, _y);      // Right
-    neighbors[2] = _zone->getBlockAt(_x, _y + 1);      // Bottom
-    neighbors[3] = _zone->getBlockAt(_x - 1, _y);      // Left
-    neighbors[4] = _zone->getBlockAt(_x + 1, _y - 1);  // Top right
-    neighbors[5] = _zone->getBlockAt(_x + 1, _y + 1);  // Bottom right
-    neighbors[6] = _zone->getBlockAt(_x - 1, _y + 1);  // Bottom left
-    neighbors[7] = _zone->getBlockAt(_x - 1, _y - 1);  // Top left
+    neighbors[0] = _zone->getBlockAt(getX(), getY() - 1);      // Top
+    neighbors[1] = _zone->getBlockAt(getX() + 1, getY());      // Right
+    neighbors[2] = _zone->getBlockAt(getX(), getY() + 1);      // Bottom
+    neighbors[3] = _zone->getBlockAt(getX() - 1, getY());      // Left
+    neighbors[4] = _zone->getBlockAt(getX() + 1, getY() - 1);  // Top right
+    neighbors[5] = _zone->getBlockAt(getX() + 1, getY() + 1);  // Bottom right
+    neighbors[6] = _zone->getBlockAt(getX() - 1, getY() + 1);  // Bottom left
+    neighbors[7] = _zone->getBlockAt(getX() - 1, getY() - 1);  // Top left
 }
 
 }  // namespace opendw
@@ -3,12 +3,15 @@
 
 #include "axmol.h"
 
+#include "zone/WorldChunk.h"
+
 namespace opendw
 {
 
 class Item;
 class MaskedSprite;
 class Physical;
+class WorldLayerRenderer;
 class WorldZone;
 
 enum class BlockLayer : uint8_t
@@ -27,22 +30,46 @@ enum class BlockLayer : uint8_t
 class BaseBlock : public ax::Object
 {
 public:
+    /* Layer data of a block that affects the environment of its neighbors. */
+    struct Layers
+    {
+        Item* baseItem;
+        Item* backItem;
+        Item* frontItem;
+        uint8_t backMod;
+        uint8_t frontMod;
+    };
+
+    /* Wholeness & continuity of a block as derived from its neighbors. */
+    struct Environment
+    {
+        uint8_t wholeness;
+        uint8_t baseContinuity;
+        uint8_t backContinuity;
+        uint8_t backModContinuity;
+        uint8_t frontContinuity;
+        uint8_t frontModContinuity;
+    };
+
     /* FUNC: BaseBlock::dealloc @ 0x100033050 */
     ~BaseBlock() override;
 
-    static BaseBlock* createWithZone(WorldZone* zone, int16_t x, int16_t y);
+    static BaseBlock* createWithChunk(WorldChunk* chunk, uint32_t slot);
 
     /* FUNC: BaseBlock::blocksAllocated @ 0x10002E308 */
     static size_t getBlocksAllocated() { return sBlocksAllocated; }
 
     /* FUNC: BaseBlock::initWithWorldZone:x:y: @ 0x10002E322 */
-    bool initWithZone(WorldZone* zone, int16_t x, int16_t y);
+    bool initWithChunk(WorldChunk* chunk, uint32_t slot);
 
     /* FUNC: BaseBlock::description @ 0x10002E3ED */
     std::string getDescription() const;
 
     /* FUNC: BaseBlock::setData:idx: @ 0x10002E798 */
-    void setData(const ax::ValueVector& data, uint32_t index);
+    void setData(const uint32_t* data, uint32_t index);
+
+    /* @return Whether the layers of this block already match the specified data. */
+    bool hasData(const uint32_t* data, uint32_t index) const;
 
     /* FUNC: BaseBlock::postPlace @ 0x10002F6F1 */
     void postPlace();
@@ -50,6 +77,16 @@ public:
     /* FUNC: BaseBlock::updateLight:liquid:wholeness:continuity: @ 0x10002F7E4 */
     void updateEnvironment(bool light = true, bool liquid = true, bool wholeness = true, bool continuity = true);
 
+    /*
+     * Computes the wholeness and/or continuity of a block from the layers of its neighbors.
+     * Neighbors are ordered the same way as getNeighbors and may be nullptr if they aren't loaded.
+     */
+    static void computeEnvironment(const Layers& layers,
+                                   const Layers* const neighbors[8],
+                                   bool wholeness,
+                                   bool continuity,
+                                   Environment& environment);
+
     /* FUNC: BaseBlock::updateNeighbors @ 0x1000321FF */
     void updateNeighbors();
 
@@ -71,11 +108,14 @@ public:
     /* FUNC: BaseBlock::continuityForLayer: @ 0x10002EE01 */
     uint8_t getContinuityForLayer(BlockLayer layer) const;
 
+    /* @return The layer data of this block as used by computeEnvironment. */
+    Layers getLayers() const;
+
     /* FUNC: BaseBlock::wholeness @ 0x1000333F0 */
-    uint8_t getWholeness() const { return _wholeness; }
+    uint8_t getWholeness() const { return _chunk->_wholeness[_slot]; }
 
     /* FUNC: BaseBlock::liquidity @ 0x100033456 */
-    uint16_t getLiquidity() const { return _liquidity; }
+    uint16_t getLiquidity() const { return _chunk->_liquidity[_slot]; }
 
     /* FUNC: BaseBlock::worldPosition @ 0x10002E60A */
     ax::Point getWorldPosition() const;
@@ -119,6 +159,13 @@ public:
     /* FUNC: BaseBlock::clearFromWorld @ 0x10003086F */
     void clearFromWorld();
     
+    /* @return Whether this block has any sprites, accessories or physics attached to it. */
+    bool hasWorldPresence() const
+    {
+        return _physical || _chunk->isColliding(_slot) || !_sprites.empty() || !_bakedRenderers.empty() ||
+               !_accessories.empty();
+    }
+
     /* FUNC: BaseBlock::clearPhysical @ 0x100030D75 */
     void clearPhysical();
 
@@ -156,6 +203,12 @@ public:
     /* FUNC: BaseBlock::recycleSprites:inLayer: @ 0x100032916 */
     void recycleSprites(BlockLayer layer = BlockLayer::NONE);
 
+    /* Moves every sprite that won't change anymore into the static chunk mesh of its renderer. */
+    void bakeSprites();
+
+    /* @return Whether any sprites of this block currently only exist as baked quads. */
+    bool hasBakedSprites() const { return !_bakedRenderers.empty(); }
+
     /* FUNC: BaseBlock::recycleSpriteWithTag: @ 0x100032810 */
     void recycleSpriteWithTag(int tag);
 
@@ -195,54 +248,51 @@ public:
     /* FUNC: BaseBlock::isWhole @ 0x10002F603 */
     bool isWhole() const;
 
-    /* FUNC: BaseBlock::setX: @ 0x1000330F9 */
-    void setX(int16_t x) { _x = x; }
-
     /* FUNC: BaseBlock::x @ 0x1000330E8 */
-    int16_t getX() const { return _x; }
-
-    /* FUNC: BaseBlock::setY: @ 0x10003311B */
-    void setY(int16_t y) { _y = y; }
+    int16_t getX() const { return _chunk->getBlockX() + _localX; }
 
     /* FUNC: BaseBlock::y @ 0x10003310A */
-    int16_t getY() const { return _y; }
+    int16_t getY() const { return _chunk->getBlockY() + _localY; }
+
+    WorldChunk* getChunk() const { return _chunk; }
+    uint32_t getSlot() const { return _slot; }
 
     /* FUNC: BaseBlock::base @ 0x10003315A */
-    uint8_t getBase() const { return _base; }
+    uint8_t getBase() const { return _chunk->_bases[_slot]; }
 
     /* FUNC: BaseBlock::liquid @ 0x10003316B */
-    uint8_t getLiquid() const { return _liquid; }
+    uint8_t getLiquid() const { return _chunk->_liquids[_slot]; }
 
     /* FUNC: BaseBlock::liquidMod @ 0x10003317C */
-    uint8_t getLiquidMod() const { return _liquidMod; }
+    uint8_t getLiquidMod() const { return _chunk->_liquidMods[_slot]; }
 
     /* FUNC: BaseBlock::back @ 0x10003318D */
-    uint16_t getBack() const { return _back; }
+    uint16_t getBack() const { return _chunk->_backs[_slot]; }
 
     /* FUNC: BaseBlock::backMod @ 0x10003319E */
-    uint8_t getBackMod() const { return _backMod; }
+    uint8_t getBackMod() const { return _chunk->_backMods[_slot]; }
 
     /* FUNC: BaseBlock::front @ 0x1000331AF */
-    uint16_t getFront() const { return _front; }
+    uint16_t getFront() const { return _chunk->_fronts[_slot]; }
 
     /* FUNC: BaseBlock::frontMod @ 0x1000331C0 */
-    uint8_t getFrontMod() const { return _frontMod; }
+    uint8_t getFrontMod() const { return _chunk->_frontMods[_slot]; }
 
     /* FUNC: BaseBlock::frontNatural @ 0x1000331D1 */
-    bool isFrontNatural() const { return _frontNatural; }
+    bool isFrontNatural() const { return _chunk->_frontNaturals[_slot]; }
 
     /* FUNC: BaseBlock::baseItem @ 0x100033536 */
-    Item* getBaseItem() const { return _baseItem; }
+    Item* getBaseItem() const { return _chunk->_baseItems[_slot]; }
 
     /* FUNC: BaseBlock::backItem @ 0x100033558 */
-    Item* getBackItem() const { return _backItem; }
+    Item* getBackItem() const { return _chunk->_backItems[_slot]; }
 
     /* FUNC: BaseBlock::frontItem @ 0x10003357A */
-    Item* getFrontItem() const { return _frontItem; }
+    Item* getFrontItem() const { return _chunk->_frontItems[_slot]; }
     Item* getRealFrontItem() const;
 
     /* FUNC: BaseBlock::liquidItem @ 0x10003359C */
-    Item* getLiquidItem() const { return _liquidItem; }
+    Item* getLiquidItem() const { return _chunk->_liquidItems[_slot]; }
 
     /* FUNC: BaseBlock::setQueuedAt: @ 0x1000334DC */
     void setQueuedAt(double time) { _queuedAt = time; }
@@ -251,40 +301,50 @@ public:
     double getQueuedAt() const { return _queuedAt; }
 
     /* FUNC: BaseBlock::setPlacing: 0x100033499 */
-    void setPlacing(bool placing) { _placing = placing; }
+    void setPlacing(bool placing) { _chunk->_placing[_slot] = placing; }
+    bool isPlacing() const { return _chunk->_placing[_slot]; }
 
     /* FUNC: BaseBlock::setRendering: @ 0x1000334BA */
-    void setRendering(bool rendering) { _rendering = rendering; }
+    void setRendering(bool rendering) { _chunk->_rendering[_slot] = rendering; }
+    bool isRendering() const { return _chunk->_rendering[_slot]; }
+
+    /* Set while the block is in the render queue so that it is never queued more than once. */
+    void setQueued(bool queued) { _chunk->_queued[_slot] = queued; }
+    bool isQueued() const { return _chunk->_queued[_slot]; }
 
     /* FUNC: BaseBlock::setCurrentLightR: @ 0x10003330E */
-    void setCurrentLightR(float value) { _currentLightR = value; }
+    void setCurrentLightR(float value) { _chunk->_lightR[_slot] = value; }
 
     /* FUNC: BaseBlock::currentLightR @ 0x1000332FC */
-    float getCurrentLightR() const { return _currentLightR; }
+    float getCurrentLightR() const { return _chunk->_lightR[_slot]; }
 
     /* FUNC: BaseBlock::setCurrentLightG: @ 0x100033332 */
-    void setCurrentLightG(float value) { _currentLightG = value; }
+    void setCurrentLightG(float value) { _chunk->_lightG[_slot] = value; }
 
     /* FUNC: BaseBlock::currentLightG @ 0x100033320 */
-    float getCurrentLightG() const { return _currentLightG; }
+    float getCurrentLightG() const { return _chunk->_lightG[_slot]; }
 
     /* FUNC: BaseBlock::setCurrentLightB: @ 0x100033356 */
-    void setCurrentLightB(float value) { _currentLightB = value; }
+    void setCurrentLightB(float value) { _chunk->_lightB[_slot] = value; }
 
     /* FUNC: BaseBlock::currentLightB @ 0x100033344 */
-    float getCurrentLightB() const { return _currentLightB; }
+    float getCurrentLightB() const { return _chunk->_lightB[_slot]; }
 
     /* FUNC: BaseBlock::setCurrentLightA: @ 0x10003337A */
-    void setCurrentLightA(float value) { _currentLightA = value; }
+    void setCurrentLightA(float value) { _chunk->_lightA[_slot] = value; }
 
     /* FUNC: BaseBlock::currentLightA @ 0x100033368 */
-    float getCurrentLightA() const { return _currentLightA; }
+    float getCurrentLightA() const { return _chunk->_lightA[_slot]; }
 
     /* FUNC: BaseBlock::setCurrentLightLit: @ 0x10003339D */
-    void setCurrentLightLit(bool value) { _currentLightLit = value; }
+    void setCurrentLightLit(bool value) { _chunk->_lightLit[_slot] = value; }
 
     /* FUNC: BaseBlock::currentLightLit @ 0x10003338C */
-    bool isCurrentLightLit() const { return _currentLightLit; }
+    bool isCurrentLightLit() const { return _chunk->_lightLit[_slot]; }
+
+    /* Cached amount of sunlight that reaches this block, before daylight and cloud cover are applied. */
+    void setCurrentLightSun(float value) { _chunk->_lightSun[_slot] = value; }
+    float getCurrentLightSun() const { return _chunk->_lightSun[_slot]; }
 
     // Continuity constants
     static constexpr auto CONTINUITY_TOP          = 0b00000001ui8;
@@ -304,40 +364,20 @@ private:
 
     inline static size_t sBlocksAllocated = 0;  // 0x10032EAA8
 
+    // NOTE: Layer, environment and lighting data lives in the owning chunk; see WorldChunk.
     WorldZone* _zone;                    // BaseBlock::zone @ 0x100310A58
-    int16_t _x;                          // BaseBlock::x @ 0x100310A60
-    int16_t _y;                          // BaseBlock::y @ 0x100310A68
-    uint8_t _base;                       // BaseBlock::base @ 0x100310A80
-    uint16_t _back;                      // BaseBlock::back @ 0x100310A88
-    uint8_t _backMod;                    // BaseBlock::backMod @ 0x100310A90
-    uint16_t _front;                     // BaseBlock::front @ 0x100310A98
-    uint8_t _frontMod;                   // BaseBlock::frontMod @ 0x100310AA0
-    bool _frontNatural;                  // BaseBlock::frontNatural @ 0x100310AA8
-    uint8_t _liquid;                     // BaseBlock::liquid @ 0x100310AB0
-    uint8_t _liquidMod;                  // BaseBlock::liquidMod @ 0x100310AB8
-    Item* _baseItem;                     // BaseBlock::baseItem @ 0x100310AC0
-    Item* _backItem;                     // BaseBlock::backItem @ 0x100310AC8
-    Item* _frontItem;                    // BaseBlock::frontItem @ 0x100310AD0
-    Item* _liquidItem;                   // BaseBlock::liquidItem @ 0x100310AD8
+    WorldChunk* _chunk;
+    uint32_t _slot;
+    int16_t _localX;
+    int16_t _localY;
     double _queuedAt;                    // BaseBlock::queuedAt @ 0x100310BB8
     ax::Vector<MaskedSprite*> _sprites;  // BaseBlock::sprites @ 0x100310B58
     ax::Vector<ax::Node*> _accessories;  // BaseBlock::accessorySprites @ 0x100310B60
-    bool _placing;                       // BaseBlock::placing @ 0x100310A70
-    bool _rendering;                     // BaseBlock::rendering @ 0x100310A78
-    uint8_t _wholeness;                  // BaseBlock::wholeness @ 0x100310B18
-    uint8_t _baseContinuity;             // BaseBlock::baseContinuity @ 0x100310AF0
-    uint8_t _backContinuity;             // BaseBlock::backContinuity @ 0x100310AE8
-    uint8_t _backModContinuity;          // BaseBlock::backModContinuity @ 0x100310B20
-    uint8_t _frontContinuity;            // BaseBlock::frontContinuity @ 0x100310AE0
-    uint8_t _frontModContinuity;         // BaseBlock::frontModContinuity @ 0x100310B28
-    uint16_t _liquidity;                 // BaseBlock::liquidity @ 0x100310B30
     Physical* _physical;                 // BaseBlock::physical @ 0x100310B38
     ax::Action* _miningAction;           // BaseBlock::miningAction @ 0x100310B50
-    float _currentLightR;                // BaseBlock::currentLightR @ 0x100310B88
-    float _currentLightG;                // BaseBlock::currentLightG @ 0x100310B90
-    float _currentLightB;                // BaseBlock::currentLightB @ 0x100310B98
-    float _currentLightA;                // BaseBlock::currentLightA @ 0x100310BA0
-    bool _currentLightLit;               // BaseBlock::currentLightLit @ 0x100310BA8
+
+    // Renderers that hold baked quads of this block
+    std::vector<WorldLayerRenderer*> _bakedRenderers;
 };
 
 }  // namespace opendw
@@ -0,0 +1,88 @@
+#include "BlockRectRange.h"
+
+#include "zone/WorldZone.h"
+
+USING_NS_AX;
+
+namespace opendw
+{
+
+BlockRectRange::BlockRectRange(WorldZone* zone, const Rect& rect)
+    : BlockRectRange(zone, (int16_t)floorf(rect.getMinX()), (int16_t)floorf(rect.getMinY()),
+                     (int16_t)floorf(rect.getMaxX()), (int16_t)floorf(rect.getMaxY()))
+{}
+
+BlockRectRange::BlockRectRange(WorldZone* zone, int16_t minX, int16_t minY, int16_t maxX, int16_t maxY)
+{
+    _zone        = zone;
+    _minX        = MAX(minX, 0);
+    _minY        = MAX(minY, 0);
+    _maxX        = MIN(maxX, zone->getBlocksWidth() - 1);
+    _maxY        = MIN(maxY, zone->getBlocksHeight() - 1);
+    _chunkWidth  = zone->getChunkWidth();
+    _chunkHeight = zone->getChunkHeight();
+}
+
+BlockRectRange::Iterator::Iterator(const BlockRectRange* range) : _range(range)
+{
+    if (!range->isEmpty())
+    {
+        seekChunk(range->_minX / range->_chunkWidth, range->_minY / range->_chunkHeight);
+    }
+}
+
+void BlockRectRange::Iterator::advance()
+{
+    if (_localY < _localMaxY)
+    {
+        _localY++;
+        _slot   = _localY * _range->_chunkWidth + _localMinX;
+        _rowEnd = _localY * _range->_chunkWidth + _localMaxX + 1;
+        return;
+    }
+
+    seekChunk(_chunkX + 1, _chunkY);
+}
+
+void BlockRectRange::Iterator::seekChunk(int16_t chunkX, int16_t chunkY)
+{
+    auto range     = _range;
+    auto minChunkX = range->_minX / range->_chunkWidth;
+    auto maxChunkX = range->_maxX / range->_chunkWidth;
+    auto maxChunkY = range->_maxY / range->_chunkHeight;
+
+    while (true)
+    {
+        if (chunkX > maxChunkX)
+        {
+            chunkX = minChunkX;
+            chunkY++;
+        }
+
+        if (chunkY > maxChunkY)
+        {
+            // Reached the end; match the default constructed end iterator
+            _chunk = nullptr;
+            _slot  = 0;
+            return;
+        }
+
+        if (auto chunk = range->_zone->getChunkAt(chunkX, chunkY))
+        {
+            _chunk     = chunk;
+            _chunkX    = chunkX;
+            _chunkY    = chunkY;
+            _localMinX = MAX(range->_minX - chunk->getBlockX(), 0);
+            _localMaxX = MIN(range->_maxX - chunk->getBlockX(), range->_chunkWidth - 1);
+            _localY    = MAX(range->_minY - chunk->getBlockY(), 0);
+            _localMaxY = MIN(range->_maxY - chunk->getBlockY(), range->_chunkHeight - 1);
+            _slot      = _localY * range->_chunkWidth + _localMinX;
+            _rowEnd    = _localY * range->_chunkWidth + _localMaxX + 1;
+            return;
+        }
+
+        chunkX++;
+    }
+}
+
+}  // namespace opendw
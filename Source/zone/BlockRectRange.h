@@ -0,0 +1,96 @@
+#ifndef __BLOCK_RECT_RANGE_H__
+#define __BLOCK_RECT_RANGE_H__
+
+#include "axmol.h"
+
+#include "zone/WorldChunk.h"
+
+namespace opendw
+{
+
+class BaseBlock;
+class WorldZone;
+
+/*
+ * Range over all loaded blocks within an inclusive block rect.
+ * The rect is walked chunk by chunk and each chunk's block array is indexed directly, so there is no per-block chunk
+ * lookup and nothing is allocated. Blocks in chunks that aren't loaded are skipped.
+ */
+class BlockRectRange
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = BaseBlock*;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = BaseBlock**;
+        using reference         = BaseBlock*;
+
+        Iterator() = default;
+        Iterator(const BlockRectRange* range);
+
+        BaseBlock* operator*() const { return _chunk->getBlockAtSlot(_slot); }
+
+        Iterator& operator++()
+        {
+            if (++_slot == _rowEnd)
+            {
+                advance();
+            }
+
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return _chunk == other._chunk && _slot == other._slot; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        /* Moves to the start of the next row, or to the next loaded chunk if this was the last row. */
+        void advance();
+
+        /* Moves to the first loaded chunk at or after the specified chunk position. */
+        void seekChunk(int16_t chunkX, int16_t chunkY);
+
+        const BlockRectRange* _range = nullptr;
+        WorldChunk* _chunk           = nullptr;
+        uint32_t _slot               = 0;
+        uint32_t _rowEnd             = 0;
+        int16_t _chunkX              = 0;
+        int16_t _chunkY              = 0;
+        int16_t _localMinX           = 0;
+        int16_t _localMaxX           = 0;
+        int16_t _localY              = 0;
+        int16_t _localMaxY           = 0;
+    };
+
+    BlockRectRange(WorldZone* zone, const ax::Rect& rect);
+    BlockRectRange(WorldZone* zone, int16_t minX, int16_t minY, int16_t maxX, int16_t maxY);
+
+    Iterator begin() const { return Iterator(this); }
+    Iterator end() const { return Iterator(); }
+
+    bool isEmpty() const { return _minX > _maxX || _minY > _maxY; }
+
+    /* @return The number of block positions covered by this range, including positions in unloaded chunks. */
+    size_t getArea() const { return isEmpty() ? 0 : (size_t)(_maxX - _minX + 1) * (_maxY - _minY + 1); }
+
+    int16_t getMinX() const { return _minX; }
+    int16_t getMinY() const { return _minY; }
+    int16_t getMaxX() const { return _maxX; }
+    int16_t getMaxY() const { return _maxY; }
+
+private:
+    WorldZone* _zone;
+    int16_t _minX;
+    int16_t _minY;
+    int16_t _maxX;
+    int16_t _maxY;
+    int16_t _chunkWidth;
+    int16_t _chunkHeight;
+};
+
+}  // namespace opendw
+
+#endif  // __BLOCK_RECT_RANGE_H__
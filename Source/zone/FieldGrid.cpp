@@ -0,0 +1,183 @@
+#include "FieldGrid.h"
+
+#include "base/DamageType.h"
+#include "base/Item.h"
+#include "util/MathUtil.h"
+#include "zone/MetaBlock.h"
+
+#define CELL_SIZE           16  // Width and height of a cell in blocks
+#define LINEAR_SEARCH_LIMIT 8   // Up to this many damage fields are simply all checked
+
+USING_NS_AX;
+
+namespace opendw
+{
+
+static const std::vector<MetaBlock*> kNoFields;
+
+/* Swaps the meta block with the last element and pops it, as the order of fields within a cell doesn't matter. */
+static void eraseField(std::vector<MetaBlock*>& fields, MetaBlock* metaBlock)
+{
+    auto it = std::find(fields.begin(), fields.end(), metaBlock);
+
+    if (it != fields.end())
+    {
+        *it = fields.back();
+        fields.pop_back();
+    }
+}
+
+void FieldGrid::reset(int16_t blocksWidth, int16_t blocksHeight)
+{
+    _blocksWidth  = blocksWidth;
+    _blocksHeight = blocksHeight;
+    _cellsX       = (blocksWidth + CELL_SIZE - 1) / CELL_SIZE;
+    _cellsY       = (blocksHeight + CELL_SIZE - 1) / CELL_SIZE;
+    _fieldCells.assign((size_t)_cellsX * _cellsY, {});
+    _damageCells.assign((size_t)_cellsX * _cellsY, {});
+    _damageFields.clear();
+}
+
+void FieldGrid::clear()
+{
+    for (auto& cell : _fieldCells)
+    {
+        cell.clear();
+    }
+
+    for (auto& cell : _damageCells)
+    {
+        cell.clear();
+    }
+
+    _damageFields.clear();
+}
+
+void FieldGrid::addField(MetaBlock* metaBlock)
+{
+    auto x     = metaBlock->getX();
+    auto y     = metaBlock->getY();
+    auto item  = metaBlock->getItem();
+    auto field = item->getField();
+    AX_ASSERT(x >= 0 && x < _blocksWidth && y >= 0 && y < _blocksHeight);
+
+    // Add to every cell that the field radius overlaps
+    auto minCellX = MAX(x - field, 0) / CELL_SIZE;
+    auto minCellY = MAX(y - field, 0) / CELL_SIZE;
+    auto maxCellX = MIN(x + field, _blocksWidth - 1) / CELL_SIZE;
+    auto maxCellY = MIN(y + field, _blocksHeight - 1) / CELL_SIZE;
+
+    for (auto cellY = minCellY; cellY <= maxCellY; cellY++)
+    {
+        for (auto cellX = minCellX; cellX <= maxCellX; cellX++)
+        {
+            _fieldCells[cellY * _cellsX + cellX].push_back(metaBlock);
+        }
+    }
+
+    if (item->getFieldDamageType() != DamageType::NONE)
+    {
+        _damageCells[y / CELL_SIZE * _cellsX + x / CELL_SIZE].push_back(metaBlock);
+        _damageFields.push_back(metaBlock);
+    }
+}
+
+void FieldGrid::removeField(MetaBlock* metaBlock)
+{
+    auto x     = metaBlock->getX();
+    auto y     = metaBlock->getY();
+    auto item  = metaBlock->getItem();
+    auto field = item->getField();
+
+    auto minCellX = MAX(x - field, 0) / CELL_SIZE;
+    auto minCellY = MAX(y - field, 0) / CELL_SIZE;
+    auto maxCellX = MIN(x + field, _blocksWidth - 1) / CELL_SIZE;
+    auto maxCellY = MIN(y + field, _blocksHeight - 1) / CELL_SIZE;
+
+    for (auto cellY = minCellY; cellY <= maxCellY; cellY++)
+    {
+        for (auto cellX = minCellX; cellX <= maxCellX; cellX++)
+        {
+            eraseField(_fieldCells[cellY * _cellsX + cellX], metaBlock);
+        }
+    }
+
+    if (item->getFieldDamageType() != DamageType::NONE)
+    {
+        eraseField(_damageCells[y / CELL_SIZE * _cellsX + x / CELL_SIZE], metaBlock);
+        eraseField(_damageFields, metaBlock);
+    }
+}
+
+const std::vector<MetaBlock*>& FieldGrid::getFieldsAt(int16_t x, int16_t y) const
+{
+    if (x < 0 || x >= _blocksWidth || y < 0 || y >= _blocksHeight)
+    {
+        return kNoFields;
+    }
+
+    return _fieldCells[y / CELL_SIZE * _cellsX + x / CELL_SIZE];
+}
+
+MetaBlock* FieldGrid::findNearestDamageField(float x, float y) const
+{
+    MetaBlock* nearest   = nullptr;
+    auto nearestDistance = 0.0F;
+
+    auto checkFields = [&](const std::vector<MetaBlock*>& fields) {
+        for (auto field : fields)
+        {
+            auto distance = math_util::getDistance(x, y, field->getX(), field->getY());
+
+            if (!nearest || distance < nearestDistance)
+            {
+                nearest         = field;
+                nearestDistance = distance;
+            }
+        }
+    };
+
+    // Most zones have only a few of these, in which case checking all of them is cheapest
+    if (_damageFields.size() <= LINEAR_SEARCH_LIMIT)
+    {
+        checkFields(_damageFields);
+        return nearest;
+    }
+
+    // Search rings of cells around the point until none of the remaining cells can have anything closer
+    int cellX   = clampf(x / CELL_SIZE, 0.0F, _cellsX - 1.0F);
+    int cellY   = clampf(y / CELL_SIZE, 0.0F, _cellsY - 1.0F);
+    int maxRing = MAX(MAX(cellX, _cellsX - 1 - cellX), MAX(cellY, _cellsY - 1 - cellY));
+
+    for (auto ring = 0; ring <= maxRing; ring++)
+    {
+        for (auto ringY = cellY - ring; ringY <= cellY + ring; ringY++)
+        {
+            if (ringY < 0 || ringY >= _cellsY)
+            {
+                continue;
+            }
+
+            // Skip the cells inside of the ring, which have been searched already
+            auto edge = ringY == cellY - ring || ringY == cellY + ring;
+            auto step = edge ? 1 : ring * 2;
+
+            for (auto ringX = cellX - ring; ringX <= cellX + ring; ringX += step)
+            {
+                if (ringX >= 0 && ringX < _cellsX)
+                {
+                    checkFields(_damageCells[ringY * _cellsX + ringX]);
+                }
+            }
+        }
+
+        if (nearest && nearestDistance <= ring * CELL_SIZE)
+        {
+            break;
+        }
+    }
+
+    return nearest;
+}
+
+}  // namespace opendw
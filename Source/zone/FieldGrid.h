@@ -0,0 +1,48 @@
+#ifndef __FIELD_GRID_H__
+#define __FIELD_GRID_H__
+
+#include "axmol.h"
+
+namespace opendw
+{
+
+class MetaBlock;
+
+/*
+ * Uniform grid over the meta blocks of a zone that have a field, so that field lookups only have to look at the
+ * fields near a point instead of all of them. Fields are added to every cell that their radius overlaps, which means
+ * that finding the fields that may cover a block is a single cell lookup no matter how large they are.
+ */
+class FieldGrid
+{
+public:
+    /* Removes all fields and resizes the grid to cover a zone of the specified size in blocks. */
+    void reset(int16_t blocksWidth, int16_t blocksHeight);
+
+    /* Removes all fields. */
+    void clear();
+
+    void addField(MetaBlock* metaBlock);
+
+    /* Must be called before the item of the meta block changes, as its field radius decides which cells it is in. */
+    void removeField(MetaBlock* metaBlock);
+
+    /* @return The fields whose radius may cover the specified block. Their distance still has to be checked. */
+    const std::vector<MetaBlock*>& getFieldsAt(int16_t x, int16_t y) const;
+
+    /* @return The field damage block nearest to the specified block point, or nullptr if there are none. */
+    MetaBlock* findNearestDamageField(float x, float y) const;
+
+private:
+    std::vector<std::vector<MetaBlock*>> _fieldCells;
+    std::vector<std::vector<MetaBlock*>> _damageCells;  // Damage fields are only added to the cell they are in
+    std::vector<MetaBlock*> _damageFields;
+    int16_t _blocksWidth  = 0;
+    int16_t _blocksHeight = 0;
+    int16_t _cellsX       = 0;
+    int16_t _cellsY       = 0;
+};
+
+}  // namespace opendw
+
+#endif  // __FIELD_GRID_H__
@@ -1,5 +1,9 @@
 #include "WorldChunk.h"
 
+#include "base/Item.h"
+#include "graphics/WorldRenderer.h"
+#include "physics/ChipmunkSpace.h"
+#include "physics/Physical.h"
 #include "zone/BaseBlock.h"
 #include "zone/WorldZone.h"
 #include "CommonDefs.h"
@@ -9,6 +13,14 @@ USING_NS_AX;
 namespace opendw
 {
 
+// Scratch buffers for recomputeEnvironment; holds the chunk's layer data with a 1-block border from adjacent chunks
+static std::vector<BaseBlock::Layers> sPaddedLayers;
+static std::vector<uint8_t> sPaddedPresent;
+static std::vector<uint8_t> sPaddedLiquid;
+
+// Scratch buffer for rebuildCollider; marks blocks that have already been merged into a rectangle
+static std::vector<uint8_t> sMergedColliders;
+
 WorldChunk::~WorldChunk()
 {
     for (uint32_t i = 0; i < _count; i++)
@@ -17,6 +29,7 @@ WorldChunk::~WorldChunk()
     }
 
     AX_SAFE_DELETE_ARRAY(_blocks);
+    AX_SAFE_RELEASE(_collider);
     sChunksAllocated--;
 }
 
@@ -32,9 +45,44 @@ bool WorldChunk::initWithZone(WorldZone* zone, int16_t x, int16_t y, uint32_t co
     _count  = count;
     _blocks = new BaseBlock*[count];
 
+    // Allocate slot data
+    _bases.assign(count, 0);
+    _backs.assign(count, 0);
+    _backMods.assign(count, 0);
+    _fronts.assign(count, 0);
+    _frontMods.assign(count, 0);
+    _frontNaturals.assign(count, 0);
+    _liquids.assign(count, 0);
+    _liquidMods.assign(count, 0);
+    _baseItems.assign(count, nullptr);
+    _backItems.assign(count, nullptr);
+    _frontItems.assign(count, nullptr);
+    _liquidItems.assign(count, nullptr);
+    _wholeness.assign(count, 0);
+    _baseContinuity.assign(count, 0);
+    _backContinuity.assign(count, 0);
+    _backModContinuity.assign(count, 0);
+    _frontContinuity.assign(count, 0);
+    _frontModContinuity.assign(count, 0);
+    _liquidity.assign(count, 0);
+    _lightR.assign(count, 0.0F);
+    _lightG.assign(count, 0.0F);
+    _lightB.assign(count, 0.0F);
+    _lightA.assign(count, 0.0F);
+    _lightLit.assign(count, 0);
+    _lightSun.assign(count, 0.0F);
+    _placing.assign(count, 1);
+    _rendering.assign(count, 0);
+    _queued.assign(count, 0);
+    _effectSlots.clear();
+    _effectIndices.assign(count, -1);
+    _colliding.assign(count, 0);
+    _collider      = nullptr;
+    _colliderDirty = false;
+
     for (uint32_t i = 0; i < count; i++)
     {
-        auto block = BaseBlock::createWithZone(zone, 0, 0);  // Block positions will be set later
+        auto block = BaseBlock::createWithChunk(this, i);
         block->retain();
         _blocks[i] = block;
     }
@@ -46,29 +94,352 @@ bool WorldChunk::initWithZone(WorldZone* zone, int16_t x, int16_t y, uint32_t co
 
 void WorldChunk::setPosition(int16_t x, int16_t y)
 {
-    _x      = x;
-    _y      = y;
-    _index  = y * _zone->getChunkCountX() + x;
-    _blockX = x * _zone->getChunkWidth();
-    _blockY = y * _zone->getChunkHeight();
+    // Block positions are derived from the chunk position, so there is no need to touch the blocks themselves
+    _x       = x;
+    _y       = y;
+    _index   = y * _zone->getChunkCountX() + x;
+    _blockX  = x * _zone->getChunkWidth();
+    _blockY  = y * _zone->getChunkHeight();
+    _beganAt = utils::gettime();
+
+    _environmentValid = false;
+    invalidateLight();
+}
+
+void WorldChunk::recycle()
+{
+    std::fill(_placing.begin(), _placing.end(), 1);  // TODO: originally sets it to 2
+    _environmentValid = false;
 
     for (uint32_t i = 0; i < _count; i++)
     {
         auto block = _blocks[i];
-        block->setX(_blockX + i % _zone->getChunkWidth());
-        block->setY(_blockY + i / _zone->getChunkWidth());
+
+        if (block->hasWorldPresence())
+        {
+            block->clearFromWorld();
+        }
     }
 
-    _beganAt = utils::gettime();
+    // Collider shapes are placed in world space, so they can't be carried over to the next position
+    rebuildCollider();
 }
 
-void WorldChunk::recycle()
+void WorldChunk::updateEffectIndex(uint32_t slot)
 {
-    for (uint32_t i = 0; i < _count; i++)
+    // Mirrors what WorldRenderer::processEffects looks for
+    auto hasAnimation = [](Item* item) {
+        return item && (item->getGlow() > 0.0F || !item->getSpriteAnimation().empty() ||
+                        !item->getSpriteContinuityAnimation().empty());
+    };
+
+    auto frontItem  = _frontItems[slot];
+    auto liquidItem = _liquidItems[slot];
+    auto hasEffects = hasAnimation(_baseItems[slot]) || hasAnimation(_backItems[slot]) || hasAnimation(frontItem) ||
+                      (frontItem && (frontItem->getEmitter() ||
+                                     frontItem->getSpecialPlacement() != SpecialPlacement::NONE)) ||
+                      (liquidItem && liquidItem->getEmitter());
+    auto index = _effectIndices[slot];
+
+    if (hasEffects && index == -1)
     {
-        auto block = _blocks[i];
-        block->setPlacing(true);  // TODO: originally sets it to 2
-        block->clearFromWorld();
+        _effectIndices[slot] = static_cast<int32_t>(_effectSlots.size());
+        _effectSlots.push_back(slot);
+    }
+    else if (!hasEffects && index != -1)
+    {
+        // Swap with the last entry to keep the index dense
+        auto last            = _effectSlots.back();
+        _effectSlots[index]  = last;
+        _effectIndices[last] = index;
+        _effectIndices[slot] = -1;
+        _effectSlots.pop_back();
+    }
+}
+
+void WorldChunk::invalidateLight(uint32_t slot)
+{
+    auto width      = _zone->getChunkWidth();
+    int16_t x       = slot % width;
+    int16_t y       = slot / width;
+    _lightDirtyMinX = MIN(_lightDirtyMinX, x);
+    _lightDirtyMinY = MIN(_lightDirtyMinY, y);
+    _lightDirtyMaxX = MAX(_lightDirtyMaxX, x);
+    _lightDirtyMaxY = MAX(_lightDirtyMaxY, y);
+}
+
+void WorldChunk::invalidateLight()
+{
+    _lightDirtyMinX = 0;
+    _lightDirtyMinY = 0;
+    _lightDirtyMaxX = _zone->getChunkWidth() - 1;
+    _lightDirtyMaxY = _zone->getChunkHeight() - 1;
+}
+
+void WorldChunk::clearLightDirty()
+{
+    _lightDirtyMinX = _zone->getChunkWidth();
+    _lightDirtyMinY = _zone->getChunkHeight();
+    _lightDirtyMaxX = -1;
+    _lightDirtyMaxY = -1;
+}
+
+Rect WorldChunk::getLightDirtyRect() const
+{
+    // Same convention as the Lightmapper screen rect: the max edge is inclusive
+    return Rect(_blockX + _lightDirtyMinX, _blockY + _lightDirtyMinY, _lightDirtyMaxX - _lightDirtyMinX,
+                _lightDirtyMaxY - _lightDirtyMinY);
+}
+
+void WorldChunk::recomputeEnvironment()
+{
+    recomputeEnvironment(false);
+}
+
+void WorldChunk::recomputeEdgeEnvironment()
+{
+    // Blocks that have not been recomputed in bulk yet will update themselves once they are placed
+    if (_environmentValid)
+    {
+        recomputeEnvironment(true);
+    }
+}
+
+void WorldChunk::recomputeEnvironment(bool edgesOnly)
+{
+    int32_t width        = _zone->getChunkWidth();
+    int32_t height       = _zone->getChunkHeight();
+    int32_t paddedWidth  = width + 2;
+    int32_t paddedHeight = height + 2;
+    auto paddedCount     = (size_t)paddedWidth * paddedHeight;
+    sPaddedLayers.resize(paddedCount);
+    sPaddedPresent.resize(paddedCount);
+    sPaddedLiquid.resize(paddedCount);
+
+    // Grab this chunk and its neighbors in a 3x3 grid
+    WorldChunk* chunks[9];
+
+    for (int32_t i = 0; i < 9; i++)
+    {
+        auto offsetX = i % 3 - 1;
+        auto offsetY = i / 3 - 1;
+        chunks[i]    = i == 4 ? this : _zone->getChunkAt(_x + offsetX, _y + offsetY);
+    }
+
+    // Copy layer data into the padded buffers
+    for (int32_t paddedY = 0; paddedY < paddedHeight; paddedY++)
+    {
+        auto localY   = paddedY - 1;
+        auto chunkRow = localY < 0 ? 0 : localY >= height ? 2 : 1;
+        auto wrappedY = localY - (chunkRow - 1) * height;
+
+        for (int32_t paddedX = 0; paddedX < paddedWidth; paddedX++)
+        {
+            // Only blocks within 2 blocks of the border are needed to update the outermost blocks
+            if (edgesOnly && paddedX > 2 && paddedX < paddedWidth - 3 && paddedY > 2 && paddedY < paddedHeight - 3)
+            {
+                continue;
+            }
+
+            auto localX   = paddedX - 1;
+            auto chunkCol = localX < 0 ? 0 : localX >= width ? 2 : 1;
+            auto wrappedX = localX - (chunkCol - 1) * width;
+            auto chunk    = chunks[chunkRow * 3 + chunkCol];
+            auto index    = paddedY * paddedWidth + paddedX;
+            auto slot     = wrappedY * width + wrappedX;
+
+            // Blocks that haven't received any data yet are treated the same as blocks that aren't loaded
+            if (!chunk || !chunk->_frontItems[slot])
+            {
+                sPaddedPresent[index] = false;
+                sPaddedLiquid[index]  = 0;
+                continue;
+            }
+
+            auto& layers          = sPaddedLayers[index];
+            layers.baseItem       = chunk->_baseItems[slot];
+            layers.backItem       = chunk->_backItems[slot];
+            layers.frontItem      = chunk->_frontItems[slot];
+            layers.backMod        = chunk->_backMods[slot];
+            layers.frontMod       = chunk->_frontMods[slot];
+            sPaddedPresent[index] = true;
+            sPaddedLiquid[index]  = chunk->_liquids[slot] > 0 ? chunk->_liquidMods[slot] & 0xF : 0;
+        }
+    }
+
+    // Neighbor offsets in the same order as BaseBlock::getNeighbors
+    const int32_t offsets[8] = {
+        -paddedWidth, 1, paddedWidth, -1, -paddedWidth + 1, paddedWidth + 1, paddedWidth - 1, -paddedWidth - 1};
+    auto renderer = _zone->getWorldRenderer();
+
+    for (int32_t y = 0; y < height; y++)
+    {
+        // Skip straight to the last column for rows in the middle if we're only updating the edges
+        auto step = edgesOnly && y > 0 && y < height - 1 ? MAX(1, width - 1) : 1;
+
+        for (int32_t x = 0; x < width; x += step)
+        {
+            auto index = (y + 1) * paddedWidth + x + 1;
+            auto slot  = y * width + x;
+
+            if (!sPaddedPresent[index])
+            {
+                continue;
+            }
+
+            const BaseBlock::Layers* neighbors[8];
+
+            for (int32_t i = 0; i < 8; i++)
+            {
+                auto neighbor = index + offsets[i];
+                neighbors[i]  = sPaddedPresent[neighbor] ? &sPaddedLayers[neighbor] : nullptr;
+            }
+
+            BaseBlock::Environment environment;
+            BaseBlock::computeEnvironment(sPaddedLayers[index], neighbors, true, true, environment);
+
+            // Liquid levels of the top, right, bottom and left neighbors
+            uint16_t liquidity = 0;
+
+            if (_liquids[slot] > 0)
+            {
+                for (int32_t i = 0; i < 4; i++)
+                {
+                    liquidity |= sPaddedLiquid[index + offsets[i]] << (i * 4);
+                }
+            }
+
+            auto changed = _wholeness[slot] != environment.wholeness ||
+                           _baseContinuity[slot] != environment.baseContinuity ||
+                           _backContinuity[slot] != environment.backContinuity ||
+                           _backModContinuity[slot] != environment.backModContinuity ||
+                           _frontContinuity[slot] != environment.frontContinuity ||
+                           _frontModContinuity[slot] != environment.frontModContinuity || _liquidity[slot] != liquidity;
+            _wholeness[slot]          = environment.wholeness;
+            _baseContinuity[slot]     = environment.baseContinuity;
+            _backContinuity[slot]     = environment.backContinuity;
+            _backModContinuity[slot]  = environment.backModContinuity;
+            _frontContinuity[slot]    = environment.frontContinuity;
+            _frontModContinuity[slot] = environment.frontModContinuity;
+            _liquidity[slot]          = liquidity;
+
+            // Blocks that are already on screen need to be redrawn if their surroundings have changed
+            if (changed && !_placing[slot] && !_rendering[slot])
+            {
+                renderer->queueBlockForRendering(_blocks[slot]);
+            }
+        }
+    }
+
+    _environmentValid = true;
+}
+
+void WorldChunk::setColliding(uint32_t slot, bool colliding)
+{
+    if (_colliding[slot] == colliding)
+    {
+        return;
+    }
+
+    _colliding[slot] = colliding;
+
+    if (!_colliderDirty)
+    {
+        _colliderDirty = true;
+        _zone->queueChunkForCollider(this);
+    }
+}
+
+void WorldChunk::rebuildCollider()
+{
+    _colliderDirty = false;
+    auto space     = _zone->getSpace();
+
+    if (_collider)
+    {
+        // The collider is only in the space while it has shapes
+        if (!_collider->getChipmunkObjects().empty())
+        {
+            space->remove(_collider);
+        }
+
+        _collider->clearShapes();
+    }
+
+    auto width  = _zone->getChunkWidth();
+    auto height = (int16_t)(_count / width);
+    sMergedColliders.assign(_count, 0);
+    auto canMerge = [&](int16_t x, int16_t y) {
+        auto slot = y * width + x;
+        return _colliding[slot] && !sMergedColliders[slot];
+    };
+
+    for (int16_t y = 0; y < height; y++)
+    {
+        for (int16_t x = 0; x < width; x++)
+        {
+            if (!canMerge(x, y))
+            {
+                continue;
+            }
+
+            // Grow the rectangle as far to the right as possible, then grow it downwards row by row
+            int16_t rectWidth  = 1;
+            int16_t rectHeight = 1;
+
+            while (x + rectWidth < width && canMerge(x + rectWidth, y))
+            {
+                rectWidth++;
+            }
+
+            while (y + rectHeight < height)
+            {
+                auto rowMergeable = true;
+
+                for (int16_t i = 0; i < rectWidth && rowMergeable; i++)
+                {
+                    rowMergeable = canMerge(x + i, y + rectHeight);
+                }
+
+                if (!rowMergeable)
+                {
+                    break;
+                }
+
+                rectHeight++;
+            }
+
+            for (int16_t j = 0; j < rectHeight; j++)
+            {
+                std::fill_n(sMergedColliders.begin() + (y + j) * width + x, rectWidth, 1);
+            }
+
+            if (!_collider)
+            {
+                _collider = Physical::createWithTarget(this);
+                _collider->retain();
+                _collider->useStaticBody();
+            }
+
+            // Same origin as BaseBlock::getWorldPosition, but for the center of the rectangle
+            auto size   = Size(rectWidth, rectHeight) * BLOCK_SIZE;
+            auto offset = Point(_blockX + x + rectWidth * 0.5F, -(_blockY + y + rectHeight * 0.5F)) * BLOCK_SIZE;
+            _collider->bindInternalShape(_collider->createBoxShape(size, offset));
+        }
+    }
+
+    if (!_collider)
+    {
+        return;
+    }
+
+    _collider->updateChipmunkObjects();
+
+    if (!_collider->getChipmunkObjects().empty())
+    {
+        _collider->setLayer(0x7D6);
+        _collider->setGroup(_zone);
+        space->add(_collider);
     }
 }
 
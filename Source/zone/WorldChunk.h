@@ -7,13 +7,21 @@ namespace opendw
 {
 
 class BaseBlock;
+class Item;
+class Physical;
 class WorldZone;
 
 /*
  * CLASS: WorldChunk : NSObject @ 0x100318958
+ *
+ * Block data is stored in packed per-chunk arrays that are indexed by slot (localY * chunkWidth + localX).
+ * BaseBlock instances are lightweight handles over these slots and only carry state that is rarely touched,
+ * such as sprites and physics bodies.
  */
 class WorldChunk : public ax::Object
 {
+    friend class BaseBlock;
+
 public:
     /* FUNC: WorldChunk::dealloc @ 0x1000CAAC6 */
     ~WorldChunk() override;
@@ -32,8 +40,60 @@ public:
     /* FUNC: WorldChunk::recycle @ 0x1000CA9D8 */
     void recycle();
 
+    /*
+     * Recomputes the wholeness, continuity and liquidity of every block in this chunk in a single pass.
+     * Blocks along the edges use the data of adjacent chunks, or are treated as having no neighbor if those aren't
+     * loaded yet.
+     */
+    void recomputeEnvironment();
+
+    /* Same as recomputeEnvironment, but only for the outermost blocks. Used when an adjacent chunk has changed. */
+    void recomputeEdgeEnvironment();
+
+    /* @return Whether the environment of this chunk has been recomputed since it last received new block data. */
+    bool isEnvironmentValid() const { return _environmentValid; }
+
+    /* Adds the block in the specified slot to the effect index or removes it, depending on its current items. */
+    void updateEffectIndex(uint32_t slot);
+
+    /* @return The slots of all blocks with items that have particles, animations or glow. */
+    const std::vector<uint32_t>& getEffectSlots() const { return _effectSlots; }
+
+    /* Marks the cached light of the block in the specified slot as out of date. */
+    void invalidateLight(uint32_t slot);
+
+    /* Marks the cached light of every block in this chunk as out of date. */
+    void invalidateLight();
+
+    /* Called by the Lightmapper once it has recomputed the out of date area. */
+    void clearLightDirty();
+
+    /* @return Whether the cached light of any block in this chunk is out of date. */
+    bool isLightDirty() const { return _lightDirtyMinX <= _lightDirtyMaxX; }
+
+    /* @return The block rect (in world block coordinates) that contains all blocks with out of date light. */
+    ax::Rect getLightDirtyRect() const;
+
+    /*
+     * Adds the block in the specified slot to the merged collider of this chunk or removes it.
+     * Only used for whole box-shaped blocks; all other shapes keep a physics body of their own.
+     */
+    void setColliding(uint32_t slot, bool colliding);
+
+    /* @return Whether the block in the specified slot is part of the merged collider of this chunk. */
+    bool isColliding(uint32_t slot) const { return _colliding[slot]; }
+
+    /* Greedily merges all colliding blocks into as few rectangles as possible and replaces the collider shapes. */
+    void rebuildCollider();
+
+    /* @return Whether blocks have been added to or removed from the collider since it was last rebuilt. */
+    bool isColliderDirty() const { return _colliderDirty; }
+
     BaseBlock* getBlockAt(int16_t x, int16_t y);
 
+    /* @return The block handle stored in the specified slot. */
+    BaseBlock* getBlockAtSlot(uint32_t slot) const { return _blocks[slot]; }
+
     /* FUNC: WorldChunk::zone @ 0x1000CAB61 */
     WorldZone* getZone() const { return _zone; }
 
@@ -58,7 +118,16 @@ public:
     /* FUNC: WorldChunk::beganAt @ 0x1000CABE9 */
     double getBeganAt() const { return _beganAt; }
 
+    // Raw slot arrays for code that scans whole chunks at once
+    const uint8_t* getBases() const { return _bases.data(); }
+    const uint16_t* getBacks() const { return _backs.data(); }
+    const uint16_t* getFronts() const { return _fronts.data(); }
+    const uint8_t* getLiquids() const { return _liquids.data(); }
+    const uint8_t* getWholeness() const { return _wholeness.data(); }
+
 private:
+    void recomputeEnvironment(bool edgesOnly);
+
     inline static size_t sChunksAllocated = 0;  // 0x100334818
 
     WorldZone* _zone;     // WorldChunk::zone @ 0x100312B48
@@ -70,6 +139,56 @@ private:
     int16_t _blockY;      // WorldChunk::blockY @ 0x100312B80
     int32_t _index;       // WorldChunk::idx @ 0x100312B70
     double _beganAt;      // WorldChunk::beganAt @ 0x100312B88
+    bool _environmentValid;
+
+    // Layer data
+    std::vector<uint8_t> _bases;
+    std::vector<uint16_t> _backs;
+    std::vector<uint8_t> _backMods;
+    std::vector<uint16_t> _fronts;
+    std::vector<uint8_t> _frontMods;
+    std::vector<uint8_t> _frontNaturals;
+    std::vector<uint8_t> _liquids;
+    std::vector<uint8_t> _liquidMods;
+    std::vector<Item*> _baseItems;
+    std::vector<Item*> _backItems;
+    std::vector<Item*> _frontItems;
+    std::vector<Item*> _liquidItems;
+
+    // Environment data
+    std::vector<uint8_t> _wholeness;
+    std::vector<uint8_t> _baseContinuity;
+    std::vector<uint8_t> _backContinuity;
+    std::vector<uint8_t> _backModContinuity;
+    std::vector<uint8_t> _frontContinuity;
+    std::vector<uint8_t> _frontModContinuity;
+    std::vector<uint16_t> _liquidity;
+
+    // Lighting data
+    std::vector<float> _lightR;
+    std::vector<float> _lightG;
+    std::vector<float> _lightB;
+    std::vector<float> _lightA;
+    std::vector<uint8_t> _lightLit;
+    std::vector<float> _lightSun;
+    int16_t _lightDirtyMinX;
+    int16_t _lightDirtyMinY;
+    int16_t _lightDirtyMaxX;
+    int16_t _lightDirtyMaxY;
+
+    // State flags
+    std::vector<uint8_t> _placing;
+    std::vector<uint8_t> _rendering;
+    std::vector<uint8_t> _queued;
+
+    // Effect index
+    std::vector<uint32_t> _effectSlots;
+    std::vector<int32_t> _effectIndices;  // Position of each slot in _effectSlots, or -1
+
+    // Merged collider
+    Physical* _collider;
+    std::vector<uint8_t> _colliding;
+    bool _colliderDirty;
 };
 
 }  // namespace opendw
@@ -1,6 +1,5 @@
 #include "WorldZone.h"
 
-#include "base/DamageType.h"
 #include "base/GameConfig.h"
 #include "base/Item.h"
 #include "base/MutableEmitter.h"
@@ -57,8 +56,9 @@ bool WorldZone::initWithGame(GameManager* game)
     _player = Player::getMain();
     _state  = State::INACTIVE;
     _inactiveChunks.reserve(CHUNK_PREALLOC_COUNT);
-    _sunlight = nullptr;
-    sMain     = this;
+    _lastChunk = nullptr;
+    _sunlight  = nullptr;
+    sMain      = this;
     return true;
 }
 
@@ -110,6 +110,8 @@ void WorldZone::configure(const ValueMap& data)
     _chunkCount  = _blockCount / _chunkSize;
     _chunkCountX = _blocksWidth / _chunkWidth;
     _chunkCountY = _blocksHeight / _chunkHeight;
+    _chunkTable.assign(_chunkCount, nullptr);
+    _lastChunk = nullptr;
     AXLOGI("[WorldZone] Block instance size: {}", sizeof(BaseBlock));
     AXLOGI("[WorldZone] Chunk instance size: {} ({} with {} blocks)", sizeof(WorldChunk),
            _chunkSize * sizeof(BaseBlock), _chunkSize);
@@ -129,6 +131,7 @@ void WorldZone::configure(const ValueMap& data)
 
     AX_SAFE_DELETE_ARRAY(_sunlight);
     _sunlight = new int16_t[_blocksWidth];
+    _fieldGrid.reset(_blocksWidth, _blocksHeight);
 
     // Preallocate a bunch of chunks if none are allocated at the moment
     if (WorldChunk::getChunksAllocated() == 0)
@@ -214,7 +217,7 @@ void WorldZone::update(float deltaTime)
             auto chunkY     = y / _chunkHeight;
             auto chunkIndex = chunkY * _chunkCountX + chunkX;
 
-            if (_chunks.find(chunkIndex) == _chunks.end())
+            if (!_chunkTable[chunkIndex])
             {
                 chunksToRequest.insert(chunkIndex);
             }
@@ -250,7 +253,7 @@ void WorldZone::update(float deltaTime)
                             auto chunkY     = y / _chunkHeight;
                             auto chunkIndex = chunkY * _chunkCountX + chunkX;
 
-                            if (_chunks.find(chunkIndex) == _chunks.end())
+                            if (!_chunkTable[chunkIndex])
                             {
                                 chunksToRequest.insert(chunkIndex);
                             }
@@ -350,31 +353,25 @@ void WorldZone::update(float deltaTime)
             _physicsBlockQueue.popBack();
         }
     }
-    
-    // 0x100042896: Find closest field damage block
-    // BUGFIX: Do this *before* updating subcomponents because _fieldDamageBlock might be deleted
-    _fieldDamageBlock    = nullptr;
-    auto playerPosition  = _player->getBlockPosition();
-    auto nearestDistance = 0.0F;
 
-    for (auto& entry : _fieldMetaBlocks)
+    // Rebuild each changed chunk collider once, no matter how many of its blocks were processed
+    if (!_colliderChunkQueue.empty())
     {
-        auto block = entry.second;
-        auto x     = block->getX();
-        auto y     = block->getY();
-        auto item  = block->getItem();
-
-        if (item->getFieldDamageType() != DamageType::NONE)
+        for (auto chunk : _colliderChunkQueue)
         {
-            auto distance = math_util::getDistance(x, y, playerPosition.x, playerPosition.y);
-
-            if (!_fieldDamageBlock || distance < nearestDistance)
+            if (chunk->isColliderDirty())
             {
-                _fieldDamageBlock = block;
-                nearestDistance   = distance;
+                chunk->rebuildCollider();
             }
         }
+
+        _colliderChunkQueue.clear();
     }
+    
+    // 0x100042896: Find closest field damage block
+    // BUGFIX: Do this *before* updating subcomponents because _fieldDamageBlock might be deleted
+    auto playerPosition = _player->getBlockPosition();
+    _fieldDamageBlock   = _fieldGrid.findNearestDamageField(playerPosition.x, playerPosition.y);
 
     // 0x10004269E: Update entities
     for (auto& entry : _entities)
@@ -613,11 +610,17 @@ void WorldZone::cleanupChunks()
         auto index = chunk->getIndex();
         chunk->recycle();
         _chunks.erase(index);
+        _chunkTable[index] = nullptr;
         _inactiveChunks.pushBack(chunk);
         it = _activeChunks.erase(it);
         _cleanedChunks.push_back(index);
         cleaned++;
 
+        if (_lastChunk == chunk)
+        {
+            _lastChunk = nullptr;
+        }
+
         if (cleaned >= 2)
         {
             break;
@@ -632,6 +635,42 @@ void WorldZone::removePendingChunk(int16_t x, int16_t y)
     _pendingChunks.erase(chunkY * _chunkCountX + chunkX);
 }
 
+void WorldZone::recomputeChunkEnvironments(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    auto minChunkX = x / _chunkWidth;
+    auto minChunkY = y / _chunkHeight;
+    auto maxChunkX = (x + width - 1) / _chunkWidth;
+    auto maxChunkY = (y + height - 1) / _chunkHeight;
+
+    for (auto chunkY = minChunkY; chunkY <= maxChunkY; chunkY++)
+    {
+        for (auto chunkX = minChunkX; chunkX <= maxChunkX; chunkX++)
+        {
+            if (auto chunk = getChunkAt(chunkX, chunkY))
+            {
+                chunk->recomputeEnvironment();
+            }
+        }
+    }
+
+    // Blocks along the edges of adjacent chunks may now have new neighbors
+    for (auto chunkY = minChunkY - 1; chunkY <= maxChunkY + 1; chunkY++)
+    {
+        for (auto chunkX = minChunkX - 1; chunkX <= maxChunkX + 1; chunkX++)
+        {
+            if (chunkX >= minChunkX && chunkX <= maxChunkX && chunkY >= minChunkY && chunkY <= maxChunkY)
+            {
+                continue;
+            }
+
+            if (auto chunk = getChunkAt(chunkX, chunkY))
+            {
+                chunk->recomputeEdgeEnvironment();
+            }
+        }
+    }
+}
+
 void WorldZone::updateSunlight(int16_t x, int16_t depth)
 {
     if (_sunlight && x >= 0 && x < _blocksWidth)
@@ -699,6 +738,7 @@ Entity* WorldZone::registerEntity(int32_t id, int32_t code, const std::string& n
     // TODO: burst
 
     _space->add(entity->getPhysical());
+    registerEntity(entity);
     return entity;
 }
 
@@ -730,6 +770,7 @@ void WorldZone::removeEntity(int32_t id, bool violent)
     }
 
     _space->remove(entity->getPhysical());
+    unregisterEntity(entity);
 
     // IMPORTANT: Do last to keep refcount
     entity->removeFromParent();  // Removes it from its respective WorldRenderer entity node
@@ -766,13 +807,25 @@ void WorldZone::leave()
     _activeChunks.clear();
     _pendingChunks.clear();
     _chunks.clear();
+    std::fill(_chunkTable.begin(), _chunkTable.end(), nullptr);
+    _lastChunk = nullptr;
     _metaBlocks.clear();
     _fieldMetaBlocks.clear();
     _fieldDisplayMetaBlocks.clear();
+    _fieldGrid.clear();
     AX_SAFE_DELETE_ARRAY(_sunlight);
     _entities.clear();
+
+    for (auto entity : _liveEntities)
+    {
+        entity->setZoneIndex(-1);
+        entity->release();
+    }
+
+    _liveEntities.clear();
     _peers.clear();
     _physicsBlockQueue.clear();
+    _colliderChunkQueue.clear();
 
     // 0x100049A02: Release physics space
     Physical::setSpace(nullptr);
@@ -787,10 +840,22 @@ BaseBlock* WorldZone::getBlockAt(int16_t x, int16_t y, bool allowChunkAlloc)
         return nullptr;
     }
 
+    // Most lookups are spatially coherent, so check the chunk of the previous lookup first
+    if (_lastChunk)
+    {
+        auto localX = x - _lastChunk->getBlockX();
+        auto localY = y - _lastChunk->getBlockY();
+
+        if (localX >= 0 && localX < _chunkWidth && localY >= 0 && localY < _chunkHeight)
+        {
+            return _lastChunk->getBlockAtSlot(localY * _chunkWidth + localX);
+        }
+    }
+
     auto chunkX     = x / _chunkWidth;
     auto chunkY     = y / _chunkHeight;
     auto chunkIndex = chunkY * _chunkCountX + chunkX;
-    auto chunk      = _chunks.at(chunkIndex);
+    auto chunk      = _chunkTable[chunkIndex];
 
     if (!chunk)
     {
@@ -814,12 +879,25 @@ BaseBlock* WorldZone::getBlockAt(int16_t x, int16_t y, bool allowChunkAlloc)
             _activeChunks.pushBack(chunk);
             _inactiveChunks.popBack();  // Do this last to prevent refcount from reaching zero
         }
+
+        _chunkTable[chunkIndex] = chunk;
     }
 
     // If chunk is nullptr at this stage then we've got bigger problems
+    _lastChunk = chunk;
     return chunk->getBlockAt(x - chunk->getBlockX(), y - chunk->getBlockY());
 }
 
+WorldChunk* WorldZone::getChunkAt(int16_t chunkX, int16_t chunkY) const
+{
+    if (chunkX < 0 || chunkX >= _chunkCountX || chunkY < 0 || chunkY >= _chunkCountY)
+    {
+        return nullptr;
+    }
+
+    return _chunkTable[chunkY * _chunkCountX + chunkX];
+}
+
 BaseBlock* WorldZone::findReachableBlock(int16_t x, int16_t y, BlockLayer layer, bool allowInvulnerable)
 {
     auto endX = MAX(0, x - 5);
@@ -888,24 +966,10 @@ Point WorldZone::getLowerRightScreenBlockPoint() const
 
 std::vector<BaseBlock*> WorldZone::getBlocksInRect(const Rect& rect)
 {
-    auto zoneRect    = Rect(0.0F, 0.0F, _blocksWidth, _blocksHeight);
-    auto clampedRect = math_util::clampRect(rect, zoneRect);
+    BlockRectRange range(this, rect);
     std::vector<BaseBlock*> blocks;
-    blocks.reserve((size_t)(ceil(clampedRect.size.width) * ceil(clampedRect.size.height)));
-
-    for (auto y = clampedRect.getMinY(); y <= clampedRect.getMaxY(); y++)
-    {
-        for (auto x = clampedRect.getMinX(); x <= clampedRect.getMaxX(); x++)
-        {
-            auto block = getBlockAt(x, y);
-
-            if (block)
-            {
-                blocks.push_back(block);
-            }
-        }
-    }
-
+    blocks.reserve(range.getArea());
+    blocks.insert(blocks.end(), range.begin(), range.end());
     return blocks;
 }
 
@@ -920,6 +984,14 @@ void WorldZone::setMetaBlock(int16_t x, int16_t y, Item* item, const ValueMap& m
     auto it    = _metaBlocks.find(index);
     MetaBlock* metaBlock;
 
+    // Take the old field out of the grid while it still has the item that decided its cells
+    auto field = _fieldMetaBlocks.find(index);
+
+    if (field != _fieldMetaBlocks.end())
+    {
+        _fieldGrid.removeField(field->second);
+    }
+
     if (it != _metaBlocks.end())
     {
         if (item)
@@ -947,6 +1019,7 @@ void WorldZone::setMetaBlock(int16_t x, int16_t y, Item* item, const ValueMap& m
         if (item->getField() > 0)
         {
             _fieldMetaBlocks[index] = metaBlock;
+            _fieldGrid.addField(metaBlock);
         }
 
         if (item->isUsableType(UseType::FIELD_DISPLAY) || item->isUsableType(UseType::MINIGAME))
@@ -989,11 +1062,47 @@ void WorldZone::showBlockInfo(BaseBlock* block) const
     _game->notify(NotificationType::ALERT, Value(text));
 }
 
+void WorldZone::registerEntity(Entity* entity)
+{
+    if (entity->getZoneIndex() != -1)
+    {
+        return;
+    }
+
+    entity->retain();
+    entity->setZoneIndex(_liveEntities.size());
+    _liveEntities.push_back(entity);
+}
+
+void WorldZone::unregisterEntity(Entity* entity)
+{
+    auto index = entity->getZoneIndex();
+
+    if (index == -1)
+    {
+        return;
+    }
+
+    // Swap with the last entity to keep the list dense
+    AX_ASSERT(_liveEntities[index] == entity);
+    auto last            = _liveEntities.back();
+    _liveEntities[index] = last;
+    last->setZoneIndex(index);
+    _liveEntities.pop_back();
+    entity->setZoneIndex(-1);
+    entity->release();
+}
+
 void WorldZone::queueBlockForPhysics(BaseBlock* block)
 {
     _physicsBlockQueue.pushBack(block);
 }
 
+void WorldZone::queueChunkForCollider(WorldChunk* chunk)
+{
+    _colliderChunkQueue.pushBack(chunk);
+}
+
 bool WorldZone::hasPhysickedAllPlacedBlocks() const
 {
     if (!_physicsBlockQueue.empty())
@@ -1059,6 +1168,18 @@ bool WorldZone::beginAvatarCollision(cpArbiter* arbiter, ChipmunkSpace* space)
             {
                 _player->onFeetCollideWithBlock(block);
             }
+            else if (dynamic_cast<WorldChunk*>(target->getUserData()) && cpArbiterGetCount(arbiter) > 0)
+            {
+                // Merged chunk colliders span many blocks, so find the one under the contact point.
+                // The contact point lies on the edge of the shape; nudge it along the normal to get inside.
+                auto point  = cpArbiterGetPointB(arbiter, 0);
+                auto normal = cpArbiterGetNormal(arbiter);
+
+                if (auto block = getBlockAtNodePoint(Point(point.x + normal.x, point.y + normal.y)))
+                {
+                    _player->onFeetCollideWithBlock(block);
+                }
+            }
         }
         else if (source == _player->getHeadShape())
         {
@@ -4,6 +4,9 @@
 #include "chipmunk/chipmunk_structs.h"  // cpArbiter
 #include "axmol.h"
 
+#include "zone/BlockRectRange.h"
+#include "zone/FieldGrid.h"
+
 namespace opendw
 {
 
@@ -86,6 +89,12 @@ public:
     /* FUNC: WorldZone::didLoadChunkX:y: @ 0x100046C6B */
     void removePendingChunk(int16_t x, int16_t y);
 
+    /*
+     * Recomputes the environment of all chunks that overlap the specified block rect, as well as the edges of any
+     * loaded chunks adjacent to them. Should be called after new block data has been received.
+     */
+    void recomputeChunkEnvironments(int16_t x, int16_t y, int16_t width, int16_t height);
+
     /* FUNC: WorldZone::updateSunlightX:depth: @ 0x100046AD2 */
     void updateSunlight(int16_t x, int16_t depth);
 
@@ -116,6 +125,9 @@ public:
     /* FUNC: 0x100045192 */
     BaseBlock* getBlockAt(int16_t x, int16_t y, bool allowChunkAlloc = false);
 
+    /* @return The active chunk at the specified chunk coordinates, or nullptr if it isn't loaded. */
+    WorldChunk* getChunkAt(int16_t chunkX, int16_t chunkY) const;
+
     /* FUNC: WorldZone::reachableBlockForOrigin:layer:allowInvulnerable: @ 0x100046945 */
     BaseBlock* findReachableBlock(int16_t x, int16_t y, BlockLayer layer, bool allowInvulnerable = false);
 
@@ -146,6 +158,16 @@ public:
     /* FUNC: WorldZone::blocksInRect: @ 0x10004664A */
     std::vector<BaseBlock*> getBlocksInRect(const ax::Rect& rect);
 
+    /* Calls the specified function for every loaded block in the specified rect without allocating anything. */
+    template <typename Callback>
+    void forEachBlockInRect(const ax::Rect& rect, Callback&& callback)
+    {
+        for (auto block : BlockRectRange(this, rect))
+        {
+            callback(block);
+        }
+    }
+
     /* FUNC: WorldZone::setMetaBlockX:y:item:metadata: @ 0x100046DBE */
     void setMetaBlock(int16_t x, int16_t y, Item* item, const ax::ValueMap& metadata);
 
@@ -156,11 +178,29 @@ public:
     const std::map<int32_t, MetaBlock*>& getFieldMetaBlocks() const { return _fieldMetaBlocks; }
     const std::map<int32_t, MetaBlock*>& getFieldDisplayMetaBlocks() const { return _fieldDisplayMetaBlocks; }
 
+    /* @return Spatial index over the field meta blocks. */
+    const FieldGrid& getFieldGrid() const { return _fieldGrid; }
+
     /* FUNC: WorldZone::showBlockInfo: @ 0x100048CFB */
     void showBlockInfo(BaseBlock* block) const;
 
+    /*
+     * Adds an entity to the live entities, which are the ones that have a physics body in the space.
+     * Does nothing if the entity has already been registered.
+     */
+    void registerEntity(Entity* entity);
+
+    /* Removes an entity from the live entities. Does nothing if the entity isn't registered. */
+    void unregisterEntity(Entity* entity);
+
+    /* @return All registered entities in no particular order. */
+    const std::vector<Entity*>& getLiveEntities() const { return _liveEntities; }
+
     void queueBlockForPhysics(BaseBlock* block);
 
+    /* Queues the merged collider of the specified chunk to be rebuilt after the current block physics batch. */
+    void queueChunkForCollider(WorldChunk* chunk);
+
     /* FUNC: WorldZone::hasPhysickedAllPlacedBlocks @ 0x1000472F4 */
     bool hasPhysickedAllPlacedBlocks() const;
 
@@ -284,12 +324,17 @@ private:
     std::map<int32_t, double> _pendingChunks;               // WorldZone::pendingChunks @ 0x100310EF0
     std::vector<int32_t> _cleanedChunks;                    // WorldZone::cleanedChunks @ 0x100310F08
     ax::Map<int32_t, WorldChunk*> _chunks;                  // WorldZone::chunks @ 0x100311088
+    std::vector<WorldChunk*> _chunkTable;                   // Dense lookup table for _chunks; indexed by chunk index
+    WorldChunk* _lastChunk;                                 // Chunk of the most recent getBlockAt call
     ax::Map<int32_t, MetaBlock*> _metaBlocks;               // WorldZone::metaBlocks @ 0x100311090
     std::map<int32_t, MetaBlock*> _fieldMetaBlocks;         // WorldZone::fieldMetaBlocks @ 0x1003110A8
     std::map<int32_t, MetaBlock*> _fieldDisplayMetaBlocks;  // BUGFIX: Show suppressor radii in vector layer
+    FieldGrid _fieldGrid;                                   // Spatial index over _fieldMetaBlocks
     ax::Map<int32_t, Entity*> _entities;                    // WorldZone::entities @ 0x100310EB8
+    std::vector<Entity*> _liveEntities;                     // Retained; each entity knows its own index
     ax::Map<int32_t, EntityAnimatedAvatar*> _peers;         // WorldZone::peers @ 0x100310EC8
     ax::Vector<BaseBlock*> _physicsBlockQueue;              // WorldZone::physicsBlockQueue @ 0x100310F40
+    ax::Vector<WorldChunk*> _colliderChunkQueue;            // Chunks with out of date merged colliders
     ax::ValueMap _machinePartsDiscovered;                   // WorldZone::machinePartsDiscovered @ 0x100311148
     std::string _documentId;                                // WorldZone::documentId @ 0x100311170
     std::string _name;                                      // WorldZone::name @ 0x100311190